@@ -0,0 +1,164 @@
+#include "BatchEnv.h"
+
+BatchEnv::BatchEnv(unsigned n, const SpriteMetrics& metrics, const PixelMask* masks,
+                   unsigned threads, uint32_t s, const EnvConfig& c)
+    : cfg(c), seed(s), worlds(n, GameWorld(metrics)),
+      obs((size_t)n * ENV_OBS_SIZE), reward(n), done(n), finalScore(n), episodes(n), lastDist(n), lastCoins(n),
+      actions(0), renderer(0), frames(0), job(JOB_RESET), generation(0), remaining(0), stopping(false) {
+    for (unsigned i = 0; i < n; ++i) worlds[i].setMasks(masks);
+
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads > n) threads = n;
+    if (threads < 1) threads = 1;
+    for (unsigned t = 1; t < threads; ++t) pool.push_back(std::thread(&BatchEnv::run, this, t));
+    reset();
+}
+
+BatchEnv::~BatchEnv() {
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (unsigned t = 0; t < pool.size(); ++t) pool[t].join();
+}
+
+void BatchEnv::reset() {
+    dispatch(JOB_RESET);
+}
+
+void BatchEnv::step(const uint8_t* a) {
+    actions = a;
+    dispatch(JOB_STEP);
+}
+
+void BatchEnv::renderFrames(const FrameRenderer& r, uint8_t* out) {
+    renderer = &r; frames = out;
+    dispatch(JOB_RENDER);
+}
+
+// ==========================================
+// 锁步线程：每步递增 generation 唤醒工作线程，调用方自己处理第 0 片，
+// 然后等 remaining 归零。条件变量与互斥量都不分配内存
+// ==========================================
+
+void BatchEnv::dispatch(Job j) {
+    job = j;
+    if (!pool.empty()) {
+        std::lock_guard<std::mutex> lock(m);
+        ++generation;
+        remaining = (unsigned)pool.size();
+    }
+    wake.notify_all();
+    runShard(0);
+    if (pool.empty()) return;
+    std::unique_lock<std::mutex> lock(m);
+    idle.wait(lock, [this] { return remaining == 0; });
+}
+
+void BatchEnv::run(unsigned shard) {
+    unsigned seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        runShard(shard);
+        std::lock_guard<std::mutex> lock(m);
+        if (--remaining == 0) idle.notify_one();
+    }
+}
+
+// 世界按连续区间分片，每个线程只写自己那段的观测与奖励
+void BatchEnv::runShard(unsigned shard) {
+    unsigned n = size(), parts = threadCount();
+    unsigned first = (unsigned)((unsigned long long)n * shard / parts);
+    unsigned last = (unsigned)((unsigned long long)n * (shard + 1) / parts);
+
+    if (job == JOB_RESET) {
+        for (unsigned i = first; i < last; ++i) {
+            episodes[i] = 0;
+            newEpisode(i);
+            reward[i] = 0; done[i] = DONE_NO; finalScore[i] = 0;
+            observe(i);
+        }
+        return;
+    }
+    if (job == JOB_RENDER) {
+        size_t frameSize = (size_t)renderer->width() * renderer->height();
+        for (unsigned i = first; i < last; ++i) renderer->render(worlds[i], frames + frameSize * i);
+        return;
+    }
+
+    for (unsigned i = first; i < last; ++i) {
+        GameWorld& w = worlds[i];
+        WorldInput in;
+        in.jump = actions[i] == ACT_JUMP;
+        in.fastFall = actions[i] == ACT_FAST_FALL;
+        unsigned ev = w.step(in);
+
+        float r = (w.dist - lastDist[i]) * cfg.distReward + (w.coins - lastCoins[i]) * cfg.coinReward;
+        lastDist[i] = w.dist; lastCoins[i] = w.coins;
+        uint8_t d = DONE_NO;
+        if (ev & EV_DIED) { r += cfg.deathReward; d = DONE_DIED; }
+        else if (cfg.maxTicks && w.tick >= cfg.maxTicks) d = DONE_TRUNCATED;
+        reward[i] = r; done[i] = d;
+
+        if (d != DONE_NO) { // 自动开下一局，观测换成新局的
+            finalScore[i] = w.score();
+            newEpisode(i);
+        }
+        observe(i);
+    }
+}
+
+// 第 i 个世界第 k 局的种子为 seed + i + k * N：互不重复，且与线程数无关
+void BatchEnv::newEpisode(unsigned i) {
+    worlds[i].reset(seed + i + episodes[i]++ * size());
+    lastDist[i] = 0; lastCoins[i] = 0;
+}
+
+void BatchEnv::observe(unsigned i) {
+    const GameWorld& w = worlds[i];
+    float* o = &obs[(size_t)i * ENV_OBS_SIZE];
+    o[0] = (w.dino.startY - w.dino.y) / 200.0f;
+    o[1] = w.dino.vy / 20.0f;
+    o[2] = w.dino.onGround ? 1.0f : 0.0f;
+    o[3] = w.spd / w.difficulty.maxSpeed;
+    o += 4;
+
+    // 仙人掌与飞鸟各自按 x 有序，归并取右边缘仍在恐龙左侧之右的前几个
+    const EntityList& c = w.cacti;
+    const EntityList& b = w.birds;
+    unsigned ci = 0, bi = 0;
+    while (ci < c.size() && c.x[c.slot(ci)] + w.metrics.w[SPR_CACTUS_L + c.type[c.slot(ci)]] <= DINO_X) ++ci;
+    while (bi < b.size() && b.x[b.slot(bi)] + w.metrics.w[SPR_BIRD_UP] <= DINO_X) ++bi;
+    for (int k = 0; k < ENV_OBSTACLES; ++k, o += 5) {
+        bool haveC = ci < c.size(), haveB = bi < b.size();
+        if (!haveC && !haveB) {
+            o[0] = 1.0f; o[1] = o[2] = o[3] = o[4] = 0;
+            continue;
+        }
+        bool bird = haveB && (!haveC || b.x[b.slot(bi)] < c.x[c.slot(ci)]);
+        unsigned s = bird ? b.slot(bi++) : c.slot(ci++);
+        const EntityList& l = bird ? b : c;
+        int id = bird ? (l.flag[s] ? SPR_BIRD_UP : SPR_BIRD_DOWN) : SPR_CACTUS_L + l.type[s];
+        o[0] = (l.x[s] - DINO_X) / WINDOW_WIDTH;
+        o[1] = l.y[s] / WINDOW_HEIGHT;
+        o[2] = w.metrics.w[id] / 100.0f;
+        o[3] = w.metrics.h[id] / 100.0f;
+        o[4] = bird ? 1.0f : 0.0f;
+    }
+
+    const EntityList& coins = w.coinList;
+    o[0] = 1.0f; o[1] = 0;
+    for (unsigned k = 0; k < coins.size(); ++k) {
+        unsigned s = coins.slot(k);
+        if (coins.flag[s] || coins.x[s] + w.metrics.w[SPR_COIN] <= DINO_X) continue;
+        o[0] = (coins.x[s] - DINO_X) / WINDOW_WIDTH;
+        o[1] = coins.y[s] / WINDOW_HEIGHT;
+        break;
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef BATCHENV_H
+#define BATCHENV_H
+
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "GameWorld.h"
+#include "ObsFrame.h"
+
+// ==========================================
+// 批量训练环境：N 个相互独立的世界，一次调用同步推进一步。
+// 规则、碰撞与窗口版完全相同（就是 GameWorld），训练出的策略可以直接用到游戏里。
+// 观测、奖励、结束标志写入构造时分配好的扁平数组；世界按连续分片分给固定的线程，
+// 每步只做一次唤醒与汇合，步进过程中不分配内存
+// ==========================================
+
+// 动作
+enum EnvAction { ACT_NONE = 0, ACT_JUMP = 1, ACT_FAST_FALL = 2 };
+
+// 结束标志
+enum EnvDone { DONE_NO = 0, DONE_DIED = 1, DONE_TRUNCATED = 2 };
+
+// 观测向量（均已归一化到约 [-1, 1]）：
+//   [0] 恐龙离地高度 / 200   [1] 竖直速度 / 20   [2] 是否着地   [3] 速度 / 最高速度
+//   之后 ENV_OBSTACLES 个最近的前方障碍物（仙人掌与飞鸟合并按 x 排序），每个 5 项：
+//   dx / 窗口宽、顶边 / 窗口高、宽 / 100、高 / 100、是否飞鸟；不足时 dx 填 1，其余为 0
+//   最后 2 项：最近的未吃金币 dx / 窗口宽、y / 窗口高（没有时为 1、0）
+const int ENV_OBSTACLES = 3;
+const int ENV_OBS_SIZE = 4 + ENV_OBSTACLES * 5 + 2;
+
+struct EnvConfig {
+    float distReward;       // 每行进 1 距离的奖励
+    float coinReward;       // 每吃一枚金币的奖励
+    float deathReward;      // 死亡的奖励（通常为负）
+    uint32_t maxTicks;      // 单局最多步数，到达后以 DONE_TRUNCATED 结束；0 表示不限
+
+    EnvConfig() : distReward(0.1f), coinReward(1.0f), deathReward(-10.0f), maxTicks(0) {}
+};
+
+class BatchEnv {
+public:
+    // masks 为空时按内缩矩形判定碰撞（同无头模式）；threads 为 0 时使用全部核心
+    BatchEnv(unsigned n, const SpriteMetrics& metrics, const PixelMask* masks = 0,
+             unsigned threads = 0, uint32_t seed = 1, const EnvConfig& cfg = EnvConfig());
+    ~BatchEnv();
+
+    // 全部世界开新局，写入初始观测
+    void reset();
+    // actions 为 size() 个 EnvAction；结束的世界自动开下一局，obs 为新局的初始观测
+    void step(const uint8_t* actions);
+    // 把每个世界的当前画面画进 out（size() 帧首尾相接，每帧 r.width() * r.height() 字节）
+    void renderFrames(const FrameRenderer& r, uint8_t* out);
+
+    unsigned size() const { return (unsigned)worlds.size(); }
+    unsigned threadCount() const { return (unsigned)pool.size() + 1; }
+
+    const float* observations() const { return obs.data(); }    // size() * ENV_OBS_SIZE
+    const float* rewards() const { return reward.data(); }      // size()
+    const uint8_t* dones() const { return done.data(); }        // size()，EnvDone
+    const int* finalScores() const { return finalScore.data(); } // done 时为刚结束那局的分数
+    const GameWorld& world(unsigned i) const { return worlds[i]; }
+
+private:
+    enum Job { JOB_RESET, JOB_STEP, JOB_RENDER };
+
+    void run(unsigned shard);           // 工作线程主循环
+    void dispatch(Job j);               // 唤醒全部线程处理各自分片，调用方处理第 0 片
+    void runShard(unsigned shard);
+    void newEpisode(unsigned i);
+    void observe(unsigned i);
+
+    EnvConfig cfg;
+    uint32_t seed;
+    std::vector<GameWorld> worlds;
+    std::vector<float> obs, reward;
+    std::vector<uint8_t> done;
+    std::vector<int> finalScore;
+    std::vector<uint32_t> episodes;     // 每个世界已开的局数，决定下一局的种子
+    std::vector<float> lastDist;
+    std::vector<int> lastCoins;
+
+    const uint8_t* actions;
+    const FrameRenderer* renderer;
+    uint8_t* frames;
+    Job job;
+    std::vector<std::thread> pool;      // 分片 1..pool.size()
+    std::mutex m;
+    std::condition_variable wake, idle;
+    unsigned generation, remaining;
+    bool stopping;
+
+    BatchEnv(const BatchEnv&);
+    BatchEnv& operator=(const BatchEnv&);
+};
+
+#endif
@@ -0,0 +1,71 @@
+#include "Bot.h"
+
+#include <algorithm>
+
+SearchBot::SearchBot() : simulatedTicks(0), move(MOVE_RUN), ticksLeft(0) {
+    beam.reserve(BOT_BEAM_WIDTH * 2);
+    next.reserve(BOT_BEAM_WIDTH * 2);
+    order.reserve(BOT_BEAM_WIDTH * 2);
+}
+
+void SearchBot::reset() {
+    move = MOVE_RUN; ticksLeft = 0;
+}
+
+WorldInput SearchBot::think(const GameWorld& w) {
+    if (ticksLeft <= 0) { move = search(w); ticksLeft = BOT_TICKS_PER_MOVE; }
+    WorldInput in;
+    in.jump = (move == MOVE_JUMP && ticksLeft == BOT_TICKS_PER_MOVE); // 起跳只在动作的第一步按下
+    in.fastFall = (move == MOVE_FAST_FALL);
+    --ticksLeft;
+    return in;
+}
+
+// 每层把束中每个状态按两种动作各推演 BOT_TICKS_PER_MOVE 步：着地时“继续跑 / 起跳”，
+// 空中时“不动 / 加速下落”（空中起跳与不动等价，不必再展开）。死掉的分支直接丢弃，
+// 活着的按 吃到的金币 - 起跳次数 排序保留前 BOT_BEAM_WIDTH 个；同分时先展开的“不动”优先
+BotMove SearchBot::search(const GameWorld& w) {
+    beam.clear();
+    beam.push_back(Node(w));
+    beam[0].world.freezeTrack();
+    order.assign(1, 0);
+    int latestDeath = -1;
+    unsigned char latestDeathFirst = MOVE_RUN;
+
+    for (int d = 0; d < BOT_HORIZON_MOVES; ++d) {
+        next.clear();
+        for (size_t k = 0; k < order.size(); ++k) {
+            const Node& parent = beam[order[k]];
+            bool ground = parent.world.dino.onGround;
+            for (int a = 0; a < 2; ++a) {
+                BotMove m = a == 0 ? MOVE_RUN : (ground ? MOVE_JUMP : MOVE_FAST_FALL);
+                next.push_back(parent);
+                Node& c = next.back();
+                if (d == 0) c.first = (unsigned char)m;
+                if (m == MOVE_JUMP) ++c.jumps;
+                bool died = false;
+                for (int t = 0; t < BOT_TICKS_PER_MOVE && !died; ++t) {
+                    WorldInput in;
+                    in.jump = (m == MOVE_JUMP && t == 0);
+                    in.fastFall = (m == MOVE_FAST_FALL);
+                    died = (c.world.step(in) & EV_DIED) != 0;
+                    ++simulatedTicks;
+                    if (died && d * BOT_TICKS_PER_MOVE + t > latestDeath) { latestDeath = d * BOT_TICKS_PER_MOVE + t; latestDeathFirst = c.first; }
+                }
+                if (died) next.pop_back();
+                else c.score = c.world.coins * 10.0f - (float)c.jumps + (c.world.dino.onGround ? 0.5f : 0.0f);
+            }
+        }
+        if (next.empty()) return (BotMove)latestDeathFirst; // 怎么走都躲不开：选死得最晚的
+        beam.swap(next);
+
+        order.resize(beam.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = (int)i;
+        const std::vector<Node>& nodes = beam;
+        std::sort(order.begin(), order.end(), [&nodes](int a, int b) { // 同分按下标，结果与排序实现无关
+            return nodes[a].score != nodes[b].score ? nodes[a].score > nodes[b].score : a < b;
+        });
+        if (order.size() > (size_t)BOT_BEAM_WIDTH) order.resize(BOT_BEAM_WIDTH);
+    }
+    return (BotMove)beam[order[0]].first;
+}
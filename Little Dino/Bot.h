@@ -0,0 +1,46 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include <vector>
+#include "GameWorld.h"
+
+// ==========================================
+// 搜索机器人：在世界的克隆上向前推演候选输入序列（束搜索），
+// 选出能活得最久的一条，执行它的第一个动作。
+// 克隆不再生成新实体，机器人只依据屏幕上已有的障碍物——与玩家能看到的一样多，
+// 因此它活不下来的局面通常说明生成器给出了躲不开的组合
+// ==========================================
+const int BOT_TICKS_PER_MOVE = 5;   // 每个动作保持的步数，也是重新规划的间隔
+const int BOT_HORIZON_MOVES = 16;   // 向前看的动作数（约 1.3 秒）
+const int BOT_BEAM_WIDTH = 8;       // 每层保留的候选数
+
+enum BotMove { MOVE_RUN, MOVE_JUMP, MOVE_FAST_FALL };
+
+class SearchBot {
+public:
+    SearchBot();
+
+    void reset();                           // 新的一局：丢弃当前计划
+    WorldInput think(const GameWorld& w);   // 本步的输入；每 BOT_TICKS_PER_MOVE 步重新搜索一次
+
+    long long simulatedTicks;               // 累计推演的步数（统计开销用）
+
+private:
+    struct Node {
+        GameWorld world;
+        unsigned char first;    // 这条序列的第一个动作
+        int jumps;
+        float score;
+
+        explicit Node(const GameWorld& w) : world(w), first(MOVE_RUN), jumps(0), score(0) {}
+    };
+
+    BotMove search(const GameWorld& w);
+
+    std::vector<Node> beam, next;   // 容量在构造时预留，搜索期间不分配内存
+    std::vector<int> order;         // beam 中得分最高的若干个下标
+    BotMove move;
+    int ticksLeft;
+};
+
+#endif
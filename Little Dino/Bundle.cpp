@@ -0,0 +1,26 @@
+#include "Bundle.h"
+
+#include <cstring>
+
+bool AssetBundle::open(const std::string& path) {
+    if (!file.open(path)) return false;
+    const uint64_t total = file.size();
+    // 先校验头和索引，之后 find()/data() 不再检查越界
+    bool ok = total >= sizeof(BundleHeader) && std::memcmp(header()->magic, BUNDLE_MAGIC, 4) == 0
+           && header()->version == BUNDLE_VERSION
+           && sizeof(BundleHeader) + (uint64_t)header()->count * sizeof(BundleEntry) <= total;
+    for (uint32_t i = 0; ok && i < header()->count; ++i) {
+        const BundleEntry& e = entries()[i];
+        ok = e.name[BUNDLE_NAME_LEN - 1] == '\0' && e.offset <= total && e.size <= total - e.offset
+          && (e.kind == BUNDLE_FILE || (e.kind == BUNDLE_RGBA && e.size == (uint64_t)e.width * e.height * 4));
+    }
+    if (!ok) file.close();
+    return ok;
+}
+
+const BundleEntry* AssetBundle::find(const std::string& name) const {
+    if (!isOpen()) return 0;
+    for (uint32_t i = 0; i < header()->count; ++i) // 条目只有十几个，线性查找即可
+        if (name == entries()[i].name) return &entries()[i];
+    return 0;
+}
@@ -0,0 +1,56 @@
+#ifndef BUNDLE_H
+#define BUNDLE_H
+
+#include <stdint.h>
+#include <string>
+#include "MappedFile.h"
+
+// ==========================================
+// 资源包格式（Game.pak，由 pack 工具生成）
+// 布局：BundleHeader | BundleEntry[count] | 数据区（16 字节对齐）
+// 所有整数均为小端序
+// ==========================================
+const char BUNDLE_MAGIC[4] = { 'D', 'P', 'A', 'K' };
+const uint32_t BUNDLE_VERSION = 1;
+const uint32_t BUNDLE_ALIGN = 16;
+const int BUNDLE_NAME_LEN = 48;
+
+enum BundleKind {
+    BUNDLE_FILE = 0, // 原始文件字节（PNG/TTF/OGG/WAV），用 loadFromMemory 打开
+    BUNDLE_RGBA = 1  // 预解码的 RGBA8 像素，width * height * 4 字节，可直接上传纹理
+};
+
+struct BundleHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct BundleEntry {
+    char name[BUNDLE_NAME_LEN]; // 以 '\0' 结尾的文件名
+    uint32_t kind;
+    uint32_t width, height;
+    uint32_t reserved;
+    uint64_t offset; // 相对文件开头
+    uint64_t size;
+};
+
+// 运行时：整个资源包只 open() 一次并映射进内存，资源直接引用映射区，不做中间拷贝
+class AssetBundle {
+public:
+    bool open(const std::string& path);
+    void close() { file.close(); }
+    bool isOpen() const { return file.isOpen(); }
+
+    const BundleEntry* find(const std::string& name) const;
+    const unsigned char* data(const BundleEntry& e) const { return file.data() + e.offset; }
+
+private:
+    const BundleHeader* header() const { return reinterpret_cast<const BundleHeader*>(file.data()); }
+    const BundleEntry* entries() const { return reinterpret_cast<const BundleEntry*>(file.data() + sizeof(BundleHeader)); }
+
+    MappedFile file;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "Collide.h"
+
+#include <cstring>
+
+#if defined(__AVX__)
+#define COLLIDE_AVX 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLIDE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const float EMPTY_LO = 1e30f, EMPTY_HI = -1e30f; // 空框：max(l) 总是大于 min(r)
+
+} // namespace
+
+bool AabbBatch::add(const WorldRect& r) {
+    if (count == AABB_CAPACITY) return false;
+    if (count % AABB_LANES == 0) { // 新的一组先整组填空框，内核读整组时不会读到未初始化数据
+        for (unsigned i = count; i < count + AABB_LANES; ++i) {
+            left[i] = top[i] = EMPTY_LO;
+            right[i] = bottom[i] = EMPTY_HI;
+        }
+    }
+    left[count] = r.left; top[count] = r.top;
+    right[count] = r.left + r.width; bottom[count] = r.top + r.height;
+    ++count;
+    return true;
+}
+
+bool CollisionHits::anyHazard() const {
+    for (unsigned w = 0; w < AABB_MASK_WORDS; ++w) if (hazard[w]) return true;
+    return false;
+}
+
+const char* aabbKernelName() {
+#if defined(COLLIDE_AVX)
+    return "avx";
+#elif defined(COLLIDE_SSE)
+    return "sse";
+#else
+    return "scalar";
+#endif
+}
+
+// 判断与 WorldRect::intersects 相同：max(左) < min(右) 且 max(上) < min(下)
+void aabbOverlapMaskScalar(const AabbBatch& b, const WorldRect& r, uint64_t* mask) {
+    const float rl = r.left, rt = r.top, rr = r.left + r.width, rb = r.top + r.height;
+    std::memset(mask, 0, AABB_MASK_WORDS * sizeof(uint64_t));
+    for (unsigned i = 0; i < b.count; ++i) {
+        float l = b.left[i] > rl ? b.left[i] : rl;
+        float x = b.right[i] < rr ? b.right[i] : rr;
+        float t = b.top[i] > rt ? b.top[i] : rt;
+        float y = b.bottom[i] < rb ? b.bottom[i] : rb;
+        if (l < x && t < y) mask[i / 64] |= (uint64_t)1 << (i % 64);
+    }
+}
+
+void aabbOverlapMask(const AabbBatch& b, const WorldRect& r, uint64_t* mask) {
+#if defined(COLLIDE_AVX)
+    std::memset(mask, 0, AABB_MASK_WORDS * sizeof(uint64_t));
+    const __m256 rl = _mm256_set1_ps(r.left), rt = _mm256_set1_ps(r.top);
+    const __m256 rr = _mm256_set1_ps(r.left + r.width), rb = _mm256_set1_ps(r.top + r.height);
+    unsigned n = b.paddedCount();
+    for (unsigned i = 0; i < n; i += 8) {
+        __m256 l = _mm256_max_ps(_mm256_loadu_ps(b.left + i), rl);
+        __m256 x = _mm256_min_ps(_mm256_loadu_ps(b.right + i), rr);
+        __m256 t = _mm256_max_ps(_mm256_loadu_ps(b.top + i), rt);
+        __m256 y = _mm256_min_ps(_mm256_loadu_ps(b.bottom + i), rb);
+        __m256 hit = _mm256_and_ps(_mm256_cmp_ps(l, x, _CMP_LT_OQ), _mm256_cmp_ps(t, y, _CMP_LT_OQ));
+        mask[i / 64] |= (uint64_t)_mm256_movemask_ps(hit) << (i % 64);
+    }
+#elif defined(COLLIDE_SSE)
+    std::memset(mask, 0, AABB_MASK_WORDS * sizeof(uint64_t));
+    const __m128 rl = _mm_set1_ps(r.left), rt = _mm_set1_ps(r.top);
+    const __m128 rr = _mm_set1_ps(r.left + r.width), rb = _mm_set1_ps(r.top + r.height);
+    unsigned n = b.paddedCount();
+    for (unsigned i = 0; i < n; i += 4) {
+        __m128 l = _mm_max_ps(_mm_loadu_ps(b.left + i), rl);
+        __m128 x = _mm_min_ps(_mm_loadu_ps(b.right + i), rr);
+        __m128 t = _mm_max_ps(_mm_loadu_ps(b.top + i), rt);
+        __m128 y = _mm_min_ps(_mm_loadu_ps(b.bottom + i), rb);
+        __m128 hit = _mm_and_ps(_mm_cmplt_ps(l, x), _mm_cmplt_ps(t, y));
+        mask[i / 64] |= (uint64_t)_mm_movemask_ps(hit) << (i % 64);
+    }
+#else
+    aabbOverlapMaskScalar(b, r, mask);
+#endif
+}
+
+void PixelMask::build(const unsigned char* rgba, int w, int h) {
+    width = w; height = h;
+    words = (w + 63) / 64;
+    bits.assign((size_t)words * h, 0); // 行尾多出的位保持为 0，窄相不需要再做掩码
+    for (int y = 0; y < h; ++y) {
+        uint64_t* row = &bits[(size_t)y * words];
+        const unsigned char* px = rgba + (size_t)y * w * 4;
+        for (int x = 0; x < w; ++x)
+            if (px[x * 4 + 3] >= MASK_ALPHA_THRESHOLD) row[x / 64] |= (uint64_t)1 << (x % 64);
+    }
+}
+
+// 一行中从第 start 列开始的 64 位，越界部分补 0
+static inline uint64_t maskRowBits(const uint64_t* row, int words, int start) {
+    if (start <= -64 || start >= words * 64) return 0;
+    if (start < 0) return row[0] << (-start);
+    int w = start / 64, s = start % 64;
+    uint64_t v = row[w] >> s;
+    if (s && w + 1 < words) v |= row[w + 1] << (64 - s);
+    return v;
+}
+
+bool pixelOverlap(const PixelMask& a, int ax, int ay, const PixelMask& b, int bx, int by) {
+    int dx = bx - ax, dy = by - ay; // 以 a 的左上角为原点
+    int x0 = dx > 0 ? dx : 0, x1 = dx + b.width < a.width ? dx + b.width : a.width;
+    int y0 = dy > 0 ? dy : 0, y1 = dy + b.height < a.height ? dy + b.height : a.height;
+    if (x0 >= x1 || y0 >= y1) return false;
+    for (int y = y0; y < y1; ++y) {
+        const uint64_t* ra = &a.bits[(size_t)y * a.words];
+        const uint64_t* rb = &b.bits[(size_t)(y - dy) * b.words];
+        for (int x = x0; x < x1; x += 64) // 重叠区以外 a 或 b 的位必为 0，不必再截断
+            if (maskRowBits(ra, a.words, x) & maskRowBits(rb, b.words, x - dx)) return true;
+    }
+    return false;
+}
+
+void collideBatch(const WorldRect& dino, const AabbBatch& hazards, const AabbBatch& coins, CollisionHits& out) {
+    aabbOverlapMask(hazards, dino, out.hazard);
+    aabbOverlapMask(coins, dino, out.coin);
+}
@@ -0,0 +1,82 @@
+#ifndef COLLIDE_H
+#define COLLIDE_H
+
+#include <stdint.h>
+#include <vector>
+
+// 与 sf::FloatRect 相同语义的矩形
+struct WorldRect {
+    float left, top, width, height;
+
+    WorldRect(float l, float t, float w, float h) : left(l), top(t), width(w), height(h) {}
+
+    bool intersects(const WorldRect& o) const {
+        float l = left > o.left ? left : o.left;
+        float r = left + width < o.left + o.width ? left + width : o.left + o.width;
+        float t = top > o.top ? top : o.top;
+        float b = top + height < o.top + o.height ? top + height : o.top + o.height;
+        return l < r && t < b;
+    }
+};
+
+// ==========================================
+// 批量 AABB 碰撞：碰撞框（已按类型内缩）按分量打包存放，
+// 与恐龙框一次比较 8 个（AVX）或 4 个（SSE），不支持时退回标量
+// ==========================================
+const unsigned AABB_CAPACITY = 128;                 // 仙人掌 + 飞鸟同屏上限
+const unsigned AABB_LANES = 8;                      // 打包粒度，AVX 一次处理的数量
+const unsigned AABB_MASK_WORDS = AABB_CAPACITY / 64;
+
+struct AabbBatch {
+    float left[AABB_CAPACITY], top[AABB_CAPACITY], right[AABB_CAPACITY], bottom[AABB_CAPACITY];
+    unsigned count;
+
+    void clear() { count = 0; }
+
+    // right/bottom 按 left + width 计算，与 WorldRect::intersects 完全一致；满了返回 false
+    bool add(const WorldRect& r);
+    // 内核读取的范围：count 向上取整到 AABB_LANES，多出的位置是永不相交的空框
+    unsigned paddedCount() const { return (count + AABB_LANES - 1) / AABB_LANES * AABB_LANES; }
+};
+
+// 第 i 位为 1 表示第 i 个框与恐龙重叠
+struct CollisionHits {
+    uint64_t hazard[AABB_MASK_WORDS];
+    uint64_t coin[AABB_MASK_WORDS];
+
+    bool anyHazard() const;
+    static bool test(const uint64_t* mask, unsigned i) { return (mask[i / 64] >> (i % 64)) & 1; }
+};
+
+// 恐龙框对全部障碍物与金币一次测完
+void collideBatch(const WorldRect& dino, const AabbBatch& hazards, const AabbBatch& coins, CollisionHits& out);
+
+// 单批次内核：结果写入 mask（AABB_MASK_WORDS 个字）
+void aabbOverlapMask(const AabbBatch& b, const WorldRect& r, uint64_t* mask);
+// 标量版本：供不支持 SIMD 的平台与基准对比
+void aabbOverlapMaskScalar(const AabbBatch& b, const WorldRect& r, uint64_t* mask);
+// 当前编译使用的内核名称（"avx" / "sse" / "scalar"）
+const char* aabbKernelName();
+
+// ==========================================
+// 像素级碰撞：贴图 alpha 通道预先压成位图，每行按 64 位一字存放，
+// AABB 命中后再把两张位图逐行移位相与（窄相）
+// ==========================================
+const unsigned char MASK_ALPHA_THRESHOLD = 128; // alpha 不低于该值的像素算实体
+
+struct PixelMask {
+    int width, height;
+    int words;                  // 每行的 64 位字数
+    std::vector<uint64_t> bits; // 行主序，第 x 列是 bits[y * words + x / 64] 的第 x % 64 位
+
+    PixelMask() : width(0), height(0), words(0) {}
+
+    // 由 RGBA8 像素构建；加载时只做一次
+    void build(const unsigned char* rgba, int w, int h);
+    bool empty() const { return bits.empty(); }
+};
+
+// a 的左上角在 (ax, ay)、b 在 (bx, by) 时是否有不透明像素重叠
+bool pixelOverlap(const PixelMask& a, int ax, int ay, const PixelMask& b, int bx, int by);
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include <cassert>
+#include <cstddef>
+
+// ==========================================
+// 实体存储（结构数组 + 定长环形缓冲）
+// 更新与碰撞只遍历连续的 x / y / type / flag；
+// 只有渲染和动画才用到的上一步位置、动画计数单独存放。
+// 障碍物从右边生成、以同一速度左移，离场顺序就是生成顺序，
+// 所以删除只需前移队头：不移动元素、不分配内存。
+// 同理，按生成顺序排列时 x 也是递增的，区间查询直接二分
+// ==========================================
+
+typedef unsigned EntityHandle;                 // 生成序号，实体存活期间保持不变
+const EntityHandle INVALID_ENTITY = 0xFFFFFFFFu;
+
+template <unsigned CAP>
+class EntityRing {
+public:
+    static_assert(CAP > 0 && (CAP & (CAP - 1)) == 0, "capacity must be a power of two");
+    static const unsigned CAPACITY = CAP;
+
+    // 热数据：每步移动、碰撞、生成检查都会读（按槽位存放，用 slot(i) 取第 i 个）
+    float x[CAP], y[CAP];
+    unsigned char type[CAP];   // 仙人掌：0 大 / 1 小 1 / 2 小 2
+    unsigned char flag[CAP];   // 金币：已收集；飞鸟：翅膀上扬
+    // 冷数据：渲染插值与动画
+    float prevX[CAP];
+    int anim[CAP];
+
+    unsigned head;   // 最早生成的实体所在槽位
+    unsigned count;
+    EntityHandle firstSeq; // 队头实体的生成序号
+
+    void clear() { head = 0; count = 0; firstSeq = 0; }
+
+    unsigned size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == CAP; }
+
+    // 第 i 个（按生成顺序）实体的槽位
+    unsigned slot(unsigned i) const { return (head + i) & (CAP - 1); }
+
+    // 满了返回 INVALID_ENTITY，不会扩容。可能满的调用方应先查 full() 并自行计数，
+    // 调试构建（未定义 NDEBUG）下在满的缓冲上 add 直接断言失败
+    EntityHandle add(float px, float py, int t, int f) {
+        assert(count < CAP && "EntityRing full: check full() before add");
+        if (count == CAP) return INVALID_ENTITY;
+        unsigned s = slot(count);
+        x[s] = px; y[s] = py;
+        type[s] = (unsigned char)t; flag[s] = (unsigned char)f;
+        prevX[s] = px; anim[s] = 0;
+        return firstSeq + count++;
+    }
+
+    // 删除最早生成的实体
+    void popFront() { head = (head + 1) & (CAP - 1); --count; ++firstSeq; }
+
+    EntityHandle handle(unsigned i) const { return firstSeq + i; }
+    bool alive(EntityHandle h) const { return h - firstSeq < count; }
+    // 句柄对应的槽位；实体已删除时返回 CAP
+    unsigned find(EntityHandle h) const { return alive(h) ? slot(h - firstSeq) : CAP; }
+
+    // 第一个 x >= v 的实体序号（0..size），要求 x 随序号递增
+    unsigned lowerBound(float v) const {
+        unsigned lo = 0, hi = count;
+        while (lo < hi) {
+            unsigned mid = (lo + hi) / 2;
+            if (x[slot(mid)] < v) lo = mid + 1; else hi = mid;
+        }
+        return lo;
+    }
+
+    // 是否有实体满足 |x - v| < r（生成间距检查）
+    bool anyWithin(float v, float r) const {
+        for (unsigned i = lowerBound(v - r); i < count; ++i) {
+            float d = x[slot(i)] - v;
+            if (d >= r) break;
+            if (d > -r) return true;
+        }
+        return false;
+    }
+
+    // 整体左移；先记下旧位置供渲染插值。存活区最多分成两段连续内存
+    void scroll(float dx) {
+        unsigned n1 = CAP - head < count ? CAP - head : count;
+        scrollRange(head, n1, dx);
+        scrollRange(0, count - n1, dx);
+    }
+
+private:
+    void scrollRange(unsigned from, unsigned n, float dx) {
+        for (unsigned i = from; i < from + n; ++i) prevX[i] = x[i];
+        for (unsigned i = from; i < from + n; ++i) x[i] -= dx;
+    }
+};
+
+const unsigned ENTITY_CAPACITY = 64;   // 每类实体同屏上限，远大于正常游戏的数量
+typedef EntityRing<ENTITY_CAPACITY> EntityList;
+
+#endif
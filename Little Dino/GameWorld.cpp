@@ -0,0 +1,198 @@
+#include "GameWorld.h"
+
+#include <cmath>
+
+GameWorld::GameWorld(const SpriteMetrics& m) : metrics(m), masks(0), difficulty(defaultDifficulty()), feed(0), trackFrozen(false), spawnDrops(0) {
+    reset(1);
+}
+
+void GameWorld::reset(uint32_t s) {
+    seed = s; tick = 0;
+    dist = 0; coins = 0; killer = -1; spd = difficulty.speedAt(0);
+    groundX[0] = 0; groundX[1] = (float)metrics.w[SPR_TRACK]; lastScroll = 0;
+    cacti.clear(); coinList.clear(); birds.clear();
+
+    dino.startY = (GROUND_Y + 30.0f) - (float)metrics.h[SPR_DINO_RUN1] + 12.0f;
+    dino.y = dino.prevY = dino.startY;
+    dino.vy = 0; dino.onGround = true; dino.showRun1 = true; dino.animTicks = 0;
+
+    track.start(seed, *this);
+    if (feed) feed->start(track, tick);
+}
+
+void GameWorld::resume() {
+    spd = difficulty.speedAt(dist); // 依行进距离恢复速度
+    tick = 0;
+    track.start(seed, *this);
+    if (feed) feed->start(track, tick);
+}
+
+void GameWorld::setFeed(TrackFeed* f) {
+    if (feed) feed->stop();
+    feed = f;
+    if (feed) feed->start(track, tick);
+}
+
+void GameWorld::restore(const WorldState& s) {
+    std::memcpy(static_cast<WorldState*>(this), &s, sizeof(WorldState));
+    if (trackFrozen) return;
+    if (feed) { feed->start(track, tick); return; }
+    TrackSpawn sp[MAX_SPAWNS_PER_TICK];
+    while (track.tick < tick) track.next(sp); // 快照来自设置了 feed 的世界时，生成器停在更早的步
+}
+
+// 同屏实体超过 ENTITY_CAPACITY（只在极端难度参数下出现）时丢弃并计数
+void GameWorld::addCactus(float x, int type) {
+    if (cacti.full()) { ++spawnDrops; return; }
+    cacti.add(x, (GROUND_Y + 30.0f) - (float)metrics.h[SPR_CACTUS_L + type % 3] + 15.0f, type % 3, 0);
+}
+
+void GameWorld::addCoin(float x, float y) {
+    if (coinList.full()) { ++spawnDrops; return; }
+    coinList.add(x, y, 0, 0);
+}
+
+// 像素碰撞下两帧翅膀的底边都要高于站立恐龙的头顶，否则站着不动也会被撞；换了贴图也成立
+void GameWorld::addBird(float x, float y) {
+    int bh = metrics.h[SPR_BIRD_DOWN] > metrics.h[SPR_BIRD_UP] ? metrics.h[SPR_BIRD_DOWN] : metrics.h[SPR_BIRD_UP];
+    if (y > dino.startY - bh) y = dino.startY - bh;
+    if (birds.full()) { ++spawnDrops; return; }
+    birds.add(x, y, 0, 1);
+}
+
+void GameWorld::setDino(float y, float vy, bool onGround) {
+    dino.y = dino.prevY = y; dino.vy = vy; dino.onGround = onGround;
+}
+
+SpriteId GameWorld::dinoSprite() const {
+    if (!dino.onGround) return SPR_DINO_JUMP;
+    return dino.showRun1 ? SPR_DINO_RUN1 : SPR_DINO_RUN2;
+}
+
+// 贴图像素坐标：按四舍五入对齐到整像素
+static inline int pixelPos(float v) { return (int)std::floor(v + 0.5f); }
+
+// 碰撞框沿用原实现：精灵矩形（飞鸟/恐龙以第一帧尺寸为准）按类型内缩
+WorldRect GameWorld::dinoBounds() const {
+    return WorldRect(DINO_X + 8, dino.y + 8, metrics.w[SPR_DINO_RUN1] - 16.0f, metrics.h[SPR_DINO_RUN1] - 16.0f);
+}
+
+WorldRect GameWorld::cactusBounds(unsigned s) const {
+    int id = SPR_CACTUS_L + cacti.type[s];
+    return WorldRect(cacti.x[s] + 6, cacti.y[s] + 6, metrics.w[id] - 12.0f, metrics.h[id] - 12.0f);
+}
+
+WorldRect GameWorld::coinBounds(unsigned s) const {
+    return WorldRect(coinList.x[s] - 5, coinList.y[s] - 5, metrics.w[SPR_COIN] + 10.0f, metrics.h[SPR_COIN] + 10.0f);
+}
+
+WorldRect GameWorld::birdBounds(unsigned s) const {
+    return WorldRect(birds.x[s] + 5, birds.y[s] + 5, metrics.w[SPR_BIRD_UP] - 10.0f, metrics.h[SPR_BIRD_UP] - 10.0f);
+}
+
+unsigned GameWorld::step(const WorldInput& in) {
+    const float dt = SIM_DT;
+    unsigned events = 0;
+
+    // --- 恐龙 ---
+    if (in.jump && dino.onGround) {
+        dino.vy = JUMP_FORCE; 
+        dino.onGround = false; 
+        events |= EV_JUMPED;
+    }
+    dino.prevY = dino.y;
+    if (!dino.onGround) { 
+        dino.vy += GRAVITY; 
+        dino.y += dino.vy; 
+        if (dino.y >= dino.startY) { 
+            dino.y = dino.startY; 
+            dino.vy = 0; 
+            dino.onGround = true; 
+            dino.showRun1 = true; 
+        }
+    }
+    ++dino.animTicks;
+    if (dino.onGround && dino.animTicks >= DINO_ANIM_TICKS) { 
+        dino.showRun1 = !dino.showRun1; 
+        dino.animTicks = 0; 
+    }
+    if (in.fastFall && !dino.onGround) { // 长按下加速下落
+        if (dino.vy < 0) dino.vy = 0; 
+        dino.vy += 5.0f; 
+    }
+
+    // --- 距离与速度 ---
+    int prevScore = score();
+    dist += spd * dt;
+    if (score() / 100 > prevScore / 100) events |= EV_MILESTONE; // 每 100 分提示一次
+    spd = difficulty.speedAt(dist);
+
+    // --- 生成：出现的时刻与位置由 TrackGenerator 决定（见 Track.h），这里按步号取用 ---
+    TrackSpawn sp[MAX_SPAWNS_PER_TICK];
+    unsigned ns = trackFrozen ? 0 : feed ? feed->take(tick, sp) : track.next(sp);
+    for (unsigned k = 0; k < ns; ++k) {
+        if (sp[k].kind == SPAWN_CACTUS) addCactus(sp[k].x, sp[k].type);
+        else if (sp[k].kind == SPAWN_COIN) addCoin(sp[k].x, sp[k].y);
+        else addBird(sp[k].x, sp[k].y);
+    }
+    ++tick;
+
+    // --- 移动 ---
+    cacti.scroll(spd); coinList.scroll(spd); birds.scroll(spd);
+    for(unsigned i=0; i<birds.size(); ++i) { 
+        unsigned s = birds.slot(i);
+        if (++birds.anim[s] >= BIRD_WING_TICKS) { birds.flag[s] = !birds.flag[s]; birds.anim[s] = 0; } // 翅膀扇动
+    }
+
+    // --- 碰撞：x 窗口内的候选打包成 AABB 批次，一次向量化测完 ---
+    // 像素模式下宽相用完整精灵矩形，命中的再逐个做位图窄相
+    SpriteId dinoId = dinoSprite();
+    WorldRect pr = masks ? WorldRect(DINO_X, dino.y, (float)metrics.w[dinoId], (float)metrics.h[dinoId]) : dinoBounds();
+    int mw = metrics.w[SPR_BIRD_UP]; // 最宽的障碍物/金币，决定窗口左沿
+    for (int id = SPR_CACTUS_L; id <= SPR_BIRD_DOWN; ++id) if (metrics.w[id] > mw && id != SPR_TRACK) mw = metrics.w[id];
+    float lo = pr.left - mw - 6, hi = pr.left + pr.width + 6; // 比各类内缩/外扩都宽，窗口内仍做精确判断
+    AabbBatch hazards, coinBoxes; 
+    hazards.clear(); coinBoxes.clear();
+    unsigned char hazardId[AABB_CAPACITY]; // 障碍物框序号 -> 精灵编号（窄相用）
+    unsigned coinSlot[AABB_CAPACITY];      // 金币框序号 -> 环形缓冲槽位
+    for(unsigned i=cacti.lowerBound(lo), e=cacti.lowerBound(hi); i<e; ++i) { 
+        unsigned s = cacti.slot(i);
+        int id = SPR_CACTUS_L + cacti.type[s];
+        hazardId[hazards.count] = (unsigned char)id;
+        hazards.add(masks ? WorldRect(cacti.x[s], cacti.y[s], (float)metrics.w[id], (float)metrics.h[id]) : cactusBounds(s)); 
+    }
+    for(unsigned i=birds.lowerBound(lo), e=birds.lowerBound(hi); i<e; ++i) { 
+        unsigned s = birds.slot(i);
+        int id = birds.flag[s] ? SPR_BIRD_UP : SPR_BIRD_DOWN;
+        hazardId[hazards.count] = (unsigned char)id;
+        hazards.add(masks ? WorldRect(birds.x[s], birds.y[s], (float)metrics.w[id], (float)metrics.h[id]) : birdBounds(s)); 
+    }
+    for(unsigned i=coinList.lowerBound(lo), e=coinList.lowerBound(hi); i<e; ++i) { 
+        unsigned s = coinList.slot(i);
+        if (!coinList.flag[s]) { coinSlot[coinBoxes.count] = s; coinBoxes.add(coinBounds(s)); } // 金币仍按放宽的矩形拾取
+    }
+
+    CollisionHits hits;
+    collideBatch(pr, hazards, coinBoxes, hits);
+    for(unsigned k=0; k<hazards.count && !(events & EV_DIED); ++k) { // 碰到仙人掌或飞鸟
+        if (!CollisionHits::test(hits.hazard, k)) continue;
+        if (masks && !pixelOverlap(masks[dinoId], pixelPos(DINO_X), pixelPos(dino.y), 
+                                   masks[hazardId[k]], pixelPos(hazards.left[k]), pixelPos(hazards.top[k]))) continue;
+        events |= EV_DIED; killer = hazardId[k];
+    }
+    for(unsigned k=0; k<coinBoxes.count; ++k) 
+        if (CollisionHits::test(hits.coin, k)) { coinList.flag[coinSlot[k]] = 1; coins++; events |= EV_COIN; } // 吃硬币加计数
+
+    // --- 清理：同类实体按生成顺序离场，只需前移队头 ---
+    while (!cacti.empty() && cacti.x[cacti.head] < -100) cacti.popFront(); // 清理离屏仙人掌
+    while (!coinList.empty() && (coinList.flag[coinList.head] || coinList.x[coinList.head] < -50)) coinList.popFront(); // 清理吃掉/离屏硬币
+    while (!birds.empty() && birds.x[birds.head] + metrics.w[SPR_BIRD_UP] < 0) birds.popFront(); // 清理离屏飞鸟
+
+    // --- 地面 ---
+    float tw = (float)metrics.w[SPR_TRACK];
+    groundX[0] -= spd; groundX[1] -= spd; lastScroll = spd;
+    if(groundX[0]+tw <= 0) groundX[0] = groundX[1]+tw; // 双贴图循环滚动地面
+    if(groundX[1]+tw <= 0) groundX[1] = groundX[0]+tw;
+
+    return events;
+}
@@ -0,0 +1,129 @@
+#ifndef GAMEWORLD_H
+#define GAMEWORLD_H
+
+#include <stdint.h>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "Collide.h"
+#include "EntityStore.h"
+#include "Sprites.h"
+#include "Track.h"
+
+// ==========================================
+// 全局常量定义（模拟规则）
+// ==========================================
+const int WINDOW_WIDTH = 800;           
+const int WINDOW_HEIGHT = 400;          
+const float GRAVITY = 0.8f;             
+const float JUMP_FORCE = -17.8f;        
+const float GROUND_Y = 250.0f;          
+const float SCORE_MULTIPLIER = 0.3f;    
+const float SPEED_MULTIPLIER = 1.4f;    
+const float MAX_SPEED = 16.0f;          
+const float MIN_BIRD_SPAWN_DISTANCE = 300.0f; 
+const float BIRD_Y = 120.0f;            // 飞鸟高度：下扇翅膀的底边也在站立恐龙的头顶之上，站着不动就能躲过（addBird 按贴图高度兜底）
+const float SIM_DT = 1.0f / 60.0f;      // 模拟固定步长；速度、重力都以“每步”为单位
+const float DINO_X = 50.0f;             
+const int DINO_ANIM_TICKS = 10;         // 跑步帧切换（原 150ms 时钟在 60 步/秒下的等价值）
+const int BIRD_WING_TICKS = 16;         // 翅膀扇动（原 0.25s 时钟）
+
+// 每一步的玩家输入
+struct WorldInput {
+    bool jump;      // 本步按下跳跃
+    bool fastFall;  // 下键按住
+
+    WorldInput() : jump(false), fastFall(false) {}
+};
+
+// step() 返回的事件位，供外部播放音效、结算
+enum WorldEvent {
+    EV_JUMPED    = 1,
+    EV_COIN      = 2,
+    EV_MILESTONE = 4,
+    EV_DIED      = 8
+};
+
+// ==========================================
+// 游戏实体（纯数据，坐标即精灵左上角）
+// 仙人掌/金币/飞鸟存放在 EntityList 里，见 EntityStore.h
+// ==========================================
+
+struct DinoState {
+    float y, prevY;     // prevY 为上一步的位置，用于渲染插值
+    float vy;
+    bool onGround;
+    bool showRun1;
+    int animTicks;
+    float startY;
+};
+
+// ==========================================
+// 模拟状态：一局的全部可变数据，定长、可平凡复制（没有指针、容器和时钟，动画也按步数计时），
+// 快照与恢复就是一次 memcpy
+// ==========================================
+struct WorldState {
+    uint32_t seed;                             // 本局种子，录像用
+    TrackGenerator track;                      // 未设置 feed 时就地生成赛道；设置时停在 feed 开始生成的那一步
+    uint32_t tick;                             // 开局/读档以来的步数，按此取用赛道
+    float dist, spd;
+    int coins;
+    int killer;                                // 撞上的障碍物精灵编号（SpriteId），存活时为 -1
+    float groundX[2], lastScroll;              // 双贴图循环地面，lastScroll 为上一步滚动量
+    DinoState dino;
+    EntityList cacti;      // type = 仙人掌类型
+    EntityList coinList;   // flag = 已收集（吃掉的金币随队头离场，不再绘制）
+    EntityList birds;      // flag = 翅膀上扬，anim = 扇动计数
+};
+
+static_assert(std::is_trivially_copyable<WorldState>::value, "WorldState must stay memcpy-able");
+
+// ==========================================
+// 游戏世界：只含模拟，不依赖窗口和渲染。
+// 状态继承自 WorldState，其余成员是这个实例的配置（贴图尺寸、碰撞位图、难度、赛道来源）
+// ==========================================
+class GameWorld : public WorldState {
+public:
+    explicit GameWorld(const SpriteMetrics& m);
+
+    // 设置后障碍物碰撞改为像素级（masks 为 SPR_COUNT 个、由调用方持有）；为空时沿用内缩矩形
+    void setMasks(const PixelMask* m) { masks = m; }
+    // 难度参数在 reset / resume 时交给赛道生成器，需在此之前设置
+    void setDifficulty(const Difficulty& d) { difficulty = d; }
+    // 设置后赛道在 feed 的工作线程上提前生成（feed 由调用方持有）；为空时每步就地生成，结果相同
+    void setFeed(TrackFeed* f);
+
+    // 此后不再生成新实体，也不再访问 feed：供机器人在克隆上推演
+    void freezeTrack() { feed = 0; trackFrozen = true; }
+
+    void reset(uint32_t seed);                 // 以指定种子开新局
+    unsigned step(const WorldInput& in);       // 推进一步，返回 WorldEvent 位
+    void resume();                             // 读档后按行进距离恢复速度，赛道从当前局面接着生成
+
+    // 快照与恢复：各一次 memcpy。恢复后赛道从快照所在的步接着生成，与没有回退时完全相同；
+    // 设置了 feed 时工作线程需重新预生成（先快进到该步），之后的第一步可能等待片刻
+    void save(WorldState& out) const { std::memcpy(&out, static_cast<const WorldState*>(this), sizeof(WorldState)); }
+    void restore(const WorldState& s);
+
+    int score() const { return (int)(dist * SCORE_MULTIPLIER); }
+
+    void addCactus(float x, int type);
+    void addCoin(float x, float y);
+    void addBird(float x, float y);
+    void setDino(float y, float vy, bool onGround);
+
+    SpriteId dinoSprite() const;                 // 当前恐龙帧
+    WorldRect dinoBounds() const;
+    WorldRect cactusBounds(unsigned slot) const;   // 参数为 EntityRing 槽位
+    WorldRect coinBounds(unsigned slot) const;
+    WorldRect birdBounds(unsigned slot) const;
+
+    SpriteMetrics metrics;
+    const PixelMask* masks;
+    Difficulty difficulty;
+    TrackFeed* feed;
+    bool trackFrozen;
+    uint32_t spawnDrops;   // 实体缓冲已满而丢弃的生成次数（此实例累计，不属于局面状态），headless/tuner 报告
+};
+
+#endif
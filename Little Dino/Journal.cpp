@@ -0,0 +1,91 @@
+#include "Journal.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "Replay.h"
+#include "SaveFile.h"
+
+static_assert(sizeof(JournalBatch) == 24 + JOURNAL_BATCH_TICKS, "journal batch must have no padding");
+
+static uint32_t batchCrc(const JournalBatch& b) {
+    return crc32(reinterpret_cast<const unsigned char*>(&b) + sizeof(b.crc), sizeof(JournalBatch) - sizeof(b.crc));
+}
+
+void JournalBatcher::begin(const GameWorld& w) {
+    on = true;
+    checkpointTick = w.tick;
+    b.tick = w.tick;
+    b.count = 0;
+}
+
+bool JournalBatcher::record(const WorldInput& in, const GameWorld& w) {
+    if (!on) return false;
+    if (b.count == JOURNAL_BATCH_TICKS) { b.tick += b.count; b.count = 0; } // 上一批已交出
+    b.inputs[b.count++] = replayBits(in, false);
+    if (b.count < JOURNAL_BATCH_TICKS) return false;
+    b.coins = w.coins;
+    b.dist = w.dist;
+    b.spd = w.spd;
+    return true;
+}
+
+bool writeJournalCheckpoint(const WorldState& s) {
+    struct {
+        SaveHeader h;
+        WorldState s;
+    } file;
+    file.s = s;
+    std::memcpy(file.h.magic, JOURNAL_MAGIC, 4);
+    file.h.version = JOURNAL_VERSION;
+    file.h.stateSize = sizeof(WorldState);
+    file.h.crc = crc32(&file.s, sizeof(WorldState));
+    return writeFileAtomic(JOURNAL_FILE, &file, sizeof(file));
+}
+
+bool appendJournal(JournalBatch b) {
+    b.crc = batchCrc(b);
+    FILE* f = std::fopen(JOURNAL_FILE, "ab");
+    if (!f) return false;
+    bool ok = std::fwrite(&b, 1, sizeof(b), f) == sizeof(b) && syncFile(f);
+    ok = std::fclose(f) == 0 && ok;
+    return ok; // 写到一半的记录恢复时因校验失败被丢弃
+}
+
+void discardJournal() {
+    std::remove(JOURNAL_FILE);
+}
+
+bool recoverJournal(GameWorld& w) {
+    FILE* f = std::fopen(JOURNAL_FILE, "rb");
+    if (!f) return false;
+    std::vector<unsigned char> buf;
+    unsigned char chunk[4096];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) buf.insert(buf.end(), chunk, chunk + n); // 最多 30 秒的批次，几 KB
+    std::fclose(f);
+    if (buf.size() < sizeof(SaveHeader) + sizeof(WorldState)) return false;
+
+    SaveHeader h;
+    std::memcpy(&h, buf.data(), sizeof(h));
+    if (std::memcmp(h.magic, JOURNAL_MAGIC, 4) != 0 || h.version != JOURNAL_VERSION || h.stateSize != sizeof(WorldState)) return false;
+    WorldState s;
+    std::memcpy(&s, buf.data() + sizeof(h), sizeof(WorldState));
+    if (crc32(&s, sizeof(WorldState)) != h.crc || !validWorldState(s)) return false;
+
+    WorldState before; // 重放中死亡时还原
+    w.save(before);
+    w.restore(s);
+    WorldState good;
+    for (size_t off = sizeof(h) + sizeof(WorldState); off + sizeof(JournalBatch) <= buf.size(); off += sizeof(JournalBatch)) {
+        JournalBatch b;
+        std::memcpy(&b, buf.data() + off, sizeof(b));
+        if (b.crc != batchCrc(b) || b.tick != w.tick || b.count == 0 || b.count > JOURNAL_BATCH_TICKS) break;
+        w.save(good);
+        bool died = false;
+        for (uint32_t i = 0; i < b.count && !died; ++i) died = (w.step(replayInput(b.inputs[i])) & EV_DIED) != 0;
+        if (died) { w.restore(before); return false; } // 崩溃时这一局其实已经结束
+        if (w.coins != b.coins || w.dist != b.dist || w.spd != b.spd) { w.restore(good); break; } // 与记录不符：停在上一批
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdint.h>
+#include "GameWorld.h"
+
+// ==========================================
+// 自动存档日志（--journal）：进程中途被杀、断电时，恢复到崩溃前一秒以内的局面。
+// autosave.jnl = SaveHeader | WorldState（检查点） | JournalBatch ...
+// 模拟是确定的，两个检查点之间的变化（新生成的障碍、吃到的金币、dist/spd）都由输入决定，
+// 所以增量记录只存每步 1 字节输入，外加批末的 dist/spd/coins 用来核对重放结果。
+// 帧线程每步只往批次里写 1 字节，每秒把一批交给持久化线程追加并刷盘；
+// 每 JOURNAL_CHECKPOINT_TICKS 步写一个完整检查点，同时整体重写文件，日志长度有上限。
+// 恢复：读检查点，按顺序重放校验通过、步号衔接的批次，遇到第一条坏记录就停
+// ==========================================
+const char JOURNAL_MAGIC[4] = { 'D', 'J', 'N', 'L' };
+const uint32_t JOURNAL_VERSION = 1;
+const char* const JOURNAL_FILE = "autosave.jnl";
+const uint32_t JOURNAL_BATCH_TICKS = 60;            // 每秒一批
+const uint32_t JOURNAL_CHECKPOINT_TICKS = 60 * 30;  // 30 秒一个检查点
+
+struct JournalBatch {
+    uint32_t crc;           // 其后全部字节的 CRC-32，追加时填
+    uint32_t tick;          // 第一步的步号
+    uint32_t count;         // 有效的输入数
+    int32_t coins;          // 重放完这一批后应得到的值
+    float dist, spd;
+    uint8_t inputs[JOURNAL_BATCH_TICKS]; // replayBits
+};
+
+// 帧线程：把每步输入攒成批次，只在内存里操作
+class JournalBatcher {
+public:
+    JournalBatcher() : on(false), checkpointTick(0) { b.count = 0; }
+
+    void begin(const GameWorld& w);    // 刚写了检查点：从 w 的当前步开始攒
+    void stop() { on = false; }
+    bool active() const { return on; }
+
+    // 每步之后调用；凑满一批时返回 true，批次在 batch() 里
+    bool record(const WorldInput& in, const GameWorld& w);
+    const JournalBatch& batch() const { return b; }
+    // 距上个检查点已足够久（只在批次边界上为真）
+    bool checkpointDue(const GameWorld& w) const {
+        return on && (b.count == 0 || b.count == JOURNAL_BATCH_TICKS) && w.tick - checkpointTick >= JOURNAL_CHECKPOINT_TICKS;
+    }
+
+private:
+    bool on;
+    uint32_t checkpointTick;
+    JournalBatch b;
+};
+
+// 以下在持久化线程上调用
+bool writeJournalCheckpoint(const WorldState& s);   // 整体重写：检查点之前的批次不再需要
+bool appendJournal(JournalBatch b);
+void discardJournal();                              // 本局正常结束
+
+// 启动时调用：有未结束的局时把 w 置为崩溃前最后一批之后的局面并返回 true；
+// 没有日志、检查点损坏或重放中已经死亡时返回 false，w 不变，由调用方删除日志
+bool recoverJournal(GameWorld& w);
+
+#endif
@@ -0,0 +1,63 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() : ptr(0), len(0), file(INVALID_HANDLE_VALUE), mapping(0) {}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    // 允许其他句柄就地写入：存档位索引映射期间仍要更新单条记录
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(file, &sz) || sz.QuadPart == 0) { close(); return false; }
+    mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+    if (!mapping) { close(); return false; }
+    ptr = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!ptr) { close(); return false; }
+    len = (std::size_t)sz.QuadPart;
+    return true;
+}
+
+void MappedFile::close() {
+    if (ptr) UnmapViewOfFile(ptr);
+    if (mapping) CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    ptr = 0; len = 0; mapping = 0; file = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+MappedFile::MappedFile() : ptr(0), len(0) {}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+    void* p = mmap(0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // 映射建立后即可关闭描述符
+    if (p == MAP_FAILED) return false;
+    ptr = static_cast<const unsigned char*>(p);
+    len = (std::size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (ptr) munmap(const_cast<unsigned char*>(ptr), len);
+    ptr = 0; len = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() { close(); }
@@ -0,0 +1,34 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// ==========================================
+// 只读内存映射文件（Windows / POSIX）
+// ==========================================
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return ptr != 0; }
+    const unsigned char* data() const { return ptr; }
+    std::size_t size() const { return len; }
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    const unsigned char* ptr;
+    std::size_t len;
+#ifdef _WIN32
+    void* file;
+    void* mapping;
+#endif
+};
+
+#endif
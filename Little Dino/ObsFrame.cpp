@@ -0,0 +1,76 @@
+#include "ObsFrame.h"
+
+#include <cmath>
+#include <cstring>
+
+static uint8_t shadeOf(int id) {
+    if (id == SPR_TRACK) return OBS_SHADE_TRACK;
+    if (id == SPR_COIN) return OBS_SHADE_COIN;
+    if (id == SPR_BIRD_UP || id == SPR_BIRD_DOWN) return OBS_SHADE_BIRD;
+    if (id >= SPR_CACTUS_L && id <= SPR_CACTUS_S2) return OBS_SHADE_CACTUS;
+    return OBS_SHADE_DINO;
+}
+
+static inline bool opaque(const PixelMask* m, int x, int y) {
+    return !m || (m->bits[(size_t)y * m->words + x / 64] >> (x % 64)) & 1;
+}
+
+FrameRenderer::FrameRenderer(int width, int height, const SpriteMetrics& metrics, const PixelMask* masks)
+    : fw(width), fh(height), sx((float)width / WINDOW_WIDTH), sy((float)height / WINDOW_HEIGHT) {
+    for (int id = 0; id < SPR_COUNT; ++id) {
+        const PixelMask* m = masks && !masks[id].empty() ? &masks[id] : 0;
+        int w = m ? m->width : metrics.w[id], h = m ? m->height : metrics.h[id];
+        Shrunk& s = sprites[id];
+        s.w = (int)std::ceil(w * sx); s.h = (int)std::ceil(h * sy);
+        s.px.assign((size_t)s.w * s.h, 0);
+        uint8_t shade = shadeOf(id);
+        // 每个目标像素对应源图中的一块，按其中不透明像素的比例取灰度（放大时至少取一个源像素）
+        for (int v = 0; v < s.h; ++v) {
+            int y0 = (int)(v / sy), y1 = (int)((v + 1) / sy);
+            if (y1 > h) y1 = h;
+            if (y1 <= y0) y1 = y0 + 1;
+            for (int u = 0; u < s.w; ++u) {
+                int x0 = (int)(u / sx), x1 = (int)((u + 1) / sx);
+                if (x1 > w) x1 = w;
+                if (x1 <= x0) x1 = x0 + 1;
+                int hit = 0;
+                for (int y = y0; y < y1 && y < h; ++y)
+                    for (int x = x0; x < x1 && x < w; ++x) hit += opaque(m, x, y);
+                s.px[(size_t)v * s.w + u] = (uint8_t)(shade * hit / ((y1 - y0) * (x1 - x0)));
+            }
+        }
+    }
+}
+
+// 左上角按四舍五入对齐到帧像素，裁掉帧外部分
+void FrameRenderer::blit(const Shrunk& s, float x, float y, uint8_t* out) const {
+    int ox = (int)std::floor(x * sx + 0.5f), oy = (int)std::floor(y * sy + 0.5f);
+    int u0 = ox < 0 ? -ox : 0, v0 = oy < 0 ? -oy : 0;
+    int u1 = ox + s.w > fw ? fw - ox : s.w, v1 = oy + s.h > fh ? fh - oy : s.h;
+    for (int v = v0; v < v1; ++v) {
+        const uint8_t* src = &s.px[(size_t)v * s.w];
+        uint8_t* dst = out + (size_t)(oy + v) * fw + ox;
+        for (int u = u0; u < u1; ++u)
+            if (src[u] > dst[u]) dst[u] = src[u];
+    }
+}
+
+void FrameRenderer::render(const GameWorld& w, uint8_t* out) const {
+    std::memset(out, 0, (size_t)fw * fh);
+    blit(sprites[SPR_TRACK], w.groundX[0], GROUND_Y + 30, out);
+    blit(sprites[SPR_TRACK], w.groundX[1], GROUND_Y + 30, out);
+    blit(sprites[w.dinoSprite()], DINO_X, w.dino.y, out);
+    const EntityList& ca = w.cacti; const EntityList& co = w.coinList; const EntityList& bi = w.birds;
+    for (unsigned i = 0; i < ca.size(); ++i) {
+        unsigned s = ca.slot(i);
+        blit(sprites[SPR_CACTUS_L + ca.type[s]], ca.x[s], ca.y[s], out);
+    }
+    for (unsigned i = 0; i < co.size(); ++i) {
+        unsigned s = co.slot(i);
+        if (!co.flag[s]) blit(sprites[SPR_COIN], co.x[s], co.y[s], out);
+    }
+    for (unsigned i = 0; i < bi.size(); ++i) {
+        unsigned s = bi.slot(i);
+        blit(sprites[bi.flag[s] ? SPR_BIRD_UP : SPR_BIRD_DOWN], bi.x[s], bi.y[s], out);
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef OBSFRAME_H
+#define OBSFRAME_H
+
+#include <stdint.h>
+#include <vector>
+#include "GameWorld.h"
+
+// ==========================================
+// 低分辨率观测帧：在 CPU 上把地面、恐龙、仙人掌、飞鸟、金币画进调用方的灰度缓冲区，
+// 不需要 GL 上下文。贴图在构造时按目标分辨率缩小成覆盖率图，每帧只做清屏与逐行取最大值。
+// 摆放与窗口版 drawWorld 相同（取本步位置，即 alpha = 1），只是按比例缩放到帧尺寸
+// ==========================================
+
+// 各类精灵的灰度（背景为 0），取最大值合成，重叠时亮的在上
+const uint8_t OBS_SHADE_TRACK = 96;
+const uint8_t OBS_SHADE_COIN = 128;
+const uint8_t OBS_SHADE_BIRD = 192;
+const uint8_t OBS_SHADE_CACTUS = 224;
+const uint8_t OBS_SHADE_DINO = 255;
+
+class FrameRenderer {
+public:
+    // masks 为 SPR_COUNT 个碰撞位图（为空时按 metrics 的整块矩形）；width x height 为帧尺寸
+    FrameRenderer(int width, int height, const SpriteMetrics& metrics, const PixelMask* masks = 0);
+
+    // out 为 width * height 字节，行主序；可在多个线程上同时调用
+    void render(const GameWorld& w, uint8_t* out) const;
+
+    int width() const { return fw; }
+    int height() const { return fh; }
+
+private:
+    // 缩小后的一张贴图：覆盖率已乘上灰度
+    struct Shrunk {
+        int w, h;
+        std::vector<uint8_t> px;
+    };
+
+    void blit(const Shrunk& s, float x, float y, uint8_t* out) const;
+
+    int fw, fh;
+    float sx, sy;   // 窗口坐标到帧坐标的缩放
+    Shrunk sprites[SPR_COUNT];
+};
+
+#endif
@@ -0,0 +1,65 @@
+#include "Persist.h"
+
+#include <cstring>
+#include <ctime>
+#include "SaveFile.h"
+
+PersistWorker::PersistWorker() : pool(1), requested(0), finished(0), reported(0), lastOk(true) {}
+
+PersistWorker::~PersistWorker() {
+    pool.wait(); // 任务引用了本对象的成员，先等它们写完
+}
+
+void PersistWorker::saveGame(const GameWorld& w, int slot, const uint8_t* thumb) {
+    WorldState snap;
+    w.save(snap);
+    SlotInfo info;
+    std::memset(&info, 0, sizeof(info));
+    info.used = 1;
+    info.savedAt = (int64_t)std::time(0);
+    info.dist = w.dist;
+    info.coins = w.coins;
+    std::memcpy(info.thumb, thumb, sizeof(info.thumb));
+    { std::lock_guard<std::mutex> lock(m); ++requested; }
+    pool.submit([this, snap, slot, info]() {
+        bool ok = writeSave(slotPath(slot), snap) && writeSlotInfo(slot, info); // 存档写好后才登记到索引
+        std::lock_guard<std::mutex> lock(m);
+        ++finished; lastOk = ok;
+    });
+}
+
+void PersistWorker::loadRuns(Leaderboard& board) {
+    RunRecord legacy;
+    if (board.load(runLog, legacy)) logRun(legacy, board); // 旧 highscore.dat 的成绩写进日志，之后不再读取
+}
+
+void PersistWorker::logRun(const RunRecord& r, const Leaderboard& board) {
+    RunIndex snap = board.index();
+    pool.submit([this, r, snap]() { runLog.append(r, snap); });
+}
+
+void PersistWorker::journalCheckpoint(const GameWorld& w) {
+    WorldState snap;
+    w.save(snap);
+    pool.submit([snap]() { writeJournalCheckpoint(snap); });
+}
+
+void PersistWorker::journalAppend(const JournalBatch& b) {
+    pool.submit([b]() { appendJournal(b); });
+}
+
+void PersistWorker::journalDiscard() {
+    pool.submit([]() { discardJournal(); });
+}
+
+bool PersistWorker::pollSaved(bool& ok) {
+    std::lock_guard<std::mutex> lock(m);
+    if (reported == finished) return false;
+    reported = finished; ok = lastOk;
+    return true;
+}
+
+bool PersistWorker::saving() const {
+    std::lock_guard<std::mutex> lock(m);
+    return finished != requested;
+}
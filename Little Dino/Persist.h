@@ -0,0 +1,49 @@
+#ifndef PERSIST_H
+#define PERSIST_H
+
+#include <mutex>
+#include "GameWorld.h"
+#include "Journal.h"
+#include "RunLog.h"
+#include "WorkerPool.h"
+
+// ==========================================
+// 持久化线程：存档与战绩记录的写盘都不在帧线程上做。
+// 帧线程只拷贝一份不可变的快照（WorldState 一次 memcpy）交给工作线程，
+// 序列化、写临时文件、刷盘、改名都在工作线程上完成，完成后帧线程通过 poll 得知结果，
+// 因此 “Progress Saved!” 只在数据真正落盘后才显示。
+// 任务按提交顺序执行；析构时等待全部写完
+// ==========================================
+class PersistWorker {
+public:
+    PersistWorker();
+    ~PersistWorker();
+
+    // 快照当前局面，稍后写入第 slot 个存档位并更新索引；thumb 为 SLOT_THUMB_W x SLOT_THUMB_H 灰度缩略图
+    void saveGame(const GameWorld& w, int slot, const uint8_t* thumb);
+    // 启动时、提交任何任务之前调用：读取排行榜，并把日志现状交给工作线程上的 RunLogWriter
+    void loadRuns(Leaderboard& board);
+    // 一局结束：稍后追加到 runs.log；board 为已计入这一局的排行榜
+    void logRun(const RunRecord& r, const Leaderboard& board);
+
+    // 自动存档日志（Journal.h）：检查点快照当前局面并重写日志；批次追加并刷盘；正常结束时删除
+    void journalCheckpoint(const GameWorld& w);
+    void journalAppend(const JournalBatch& b);
+    void journalDiscard();
+
+    // 帧线程每帧调用：有存档写完时返回 true，ok 为是否成功
+    bool pollSaved(bool& ok);
+    bool saving() const;                        // 还有存档没写完
+
+private:
+    WorkerPool pool;            // 单个工作线程，任务串行
+    mutable std::mutex m;
+    unsigned requested, finished, reported;     // 存档请求数 / 已写完数 / 已通知帧线程数
+    bool lastOk;
+    RunLogWriter runLog;        // 只在工作线程上使用
+
+    PersistWorker(const PersistWorker&);
+    PersistWorker& operator=(const PersistWorker&);
+};
+
+#endif
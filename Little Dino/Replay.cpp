@@ -0,0 +1,116 @@
+#include "Replay.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+uint8_t replayBits(const WorldInput& in, bool pausedBefore) {
+    return (uint8_t)((in.jump ? RIN_JUMP : 0) | (in.fastFall ? RIN_FAST_FALL : 0) | (pausedBefore ? RIN_PAUSE : 0));
+}
+
+WorldInput replayInput(uint8_t bits) {
+    WorldInput in;
+    in.jump = (bits & RIN_JUMP) != 0;
+    in.fastFall = (bits & RIN_FAST_FALL) != 0;
+    return in;
+}
+
+// ==========================================
+// 录制
+// ==========================================
+
+void ReplayRecorder::begin(uint32_t s, uint32_t f) {
+    log.clear();
+    log.reserve(16 * 1024); // 一局通常只有几百次变化，录制期间基本不会再分配
+    ticks = 0; changes = 0; last = 0; lastTick = 0;
+    seed = s; flags = f;
+}
+
+void ReplayRecorder::record(uint8_t bits) {
+    if (bits != last) {
+        uint32_t delta = ticks - lastTick;
+        while (delta >= 0x80) { log.push_back((uint8_t)(delta | 0x80)); delta >>= 7; } // 7 位一组的变长整数
+        log.push_back((uint8_t)delta);
+        log.push_back(bits);
+        last = bits; lastTick = ticks; ++changes;
+    }
+    ++ticks;
+}
+
+bool ReplayRecorder::save(const std::string& path) const {
+    ReplayHeader h;
+    std::memcpy(h.magic, REPLAY_MAGIC, 4);
+    h.version = REPLAY_VERSION; h.seed = seed; h.flags = flags;
+    h.ticks = ticks; h.changes = changes;
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    if (!log.empty()) out.write(reinterpret_cast<const char*>(log.data()), (std::streamsize)log.size());
+    return out.good();
+}
+
+// ==========================================
+// 重放
+// ==========================================
+
+// 一条变化记录：变长整数（uint32 最多 5 组 7 位）+ 1 字节输入位。过长或在记录中途结束时返回 false
+static bool decodeChange(const std::vector<uint8_t>& log, size_t& pos, uint32_t& delta, uint8_t& bits) {
+    delta = 0;
+    for (int shift = 0; ; shift += 7) {
+        if (shift > 28 || pos >= log.size()) return false;
+        uint8_t b = log[pos++];
+        delta |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) break;
+    }
+    if (pos >= log.size()) return false;
+    bits = log[pos++];
+    return true;
+}
+
+ReplayPlayer::ReplayPlayer() : pos(0), tick(0), nextChange(0), current(0), pending(0), changesLeft(0) {
+    std::memset(&header, 0, sizeof(header));
+}
+
+bool ReplayPlayer::load(const std::string& path) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in.is_open()) return false;
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(ReplayHeader)) return false;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, REPLAY_MAGIC, 4) != 0 || header.version != REPLAY_VERSION) return false;
+    log.assign(data.begin() + sizeof(ReplayHeader), data.end());
+    // 先把全部变化记录解码一遍：损坏或截断的录像直接拒绝，而不是重放出错乱的输入
+    size_t p = 0;
+    uint32_t delta;
+    uint8_t bits;
+    for (uint32_t i = 0; i < header.changes; ++i) if (!decodeChange(log, p, delta, bits)) { log.clear(); header.changes = 0; return false; }
+    rewind();
+    return true;
+}
+
+void ReplayPlayer::rewind() {
+    pos = 0; tick = 0; current = 0; nextChange = 0;
+    changesLeft = header.changes;
+    if (changesLeft) readChange();
+}
+
+// 读出下一条变化：nextChange 在上一条的基础上累加（load 已校验过全部记录）
+void ReplayPlayer::readChange() {
+    uint32_t delta = 0;
+    decodeChange(log, pos, delta, pending);
+    nextChange += delta;
+}
+
+uint8_t ReplayPlayer::peek() {
+    if (changesLeft && tick == nextChange) { // 变化在本步生效
+        current = pending;
+        if (--changesLeft) readChange();
+    }
+    return current;
+}
+
+uint8_t ReplayPlayer::next() {
+    uint8_t bits = peek();
+    ++tick;
+    return bits;
+}
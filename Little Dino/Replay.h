@@ -0,0 +1,82 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "GameWorld.h"
+
+// ==========================================
+// 录像：种子 + 逐步输入，重放时重新模拟即可得到完全相同的一局
+// 文件布局：ReplayHeader | 变化记录（小端序）
+// 每条变化记录 = 距上一条的步数（变长整数）+ 新的输入位（1 字节），输入不变的步不占空间
+// ==========================================
+const char REPLAY_MAGIC[4] = { 'D', 'R', 'E', 'P' };
+const uint32_t REPLAY_VERSION = 3;   // 3：飞鸟与仙人掌的间隔随速度变化；2：赛道改由 TrackGenerator 生成。旧录像无法复现
+
+enum ReplayInput {
+    RIN_JUMP      = 1,  // 本步起跳
+    RIN_FAST_FALL = 2,  // 下键按住
+    RIN_PAUSE     = 4   // 本步之前玩家暂停过（窗口重放时在此处倒计时）
+};
+
+enum ReplayFlag {
+    REPLAY_PIXEL_COLLISION = 1  // 录制时使用像素级碰撞
+};
+
+struct ReplayHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t seed;
+    uint32_t flags;
+    uint32_t ticks;     // 总步数
+    uint32_t changes;   // 变化记录条数
+};
+
+uint8_t replayBits(const WorldInput& in, bool pausedBefore);
+WorldInput replayInput(uint8_t bits);
+
+class ReplayRecorder {
+public:
+    ReplayRecorder() : ticks(0), changes(0), last(0), lastTick(0), seed(0), flags(0) {}
+
+    void begin(uint32_t seed, uint32_t flags);
+    void record(uint8_t bits);              // 每步调用一次
+    bool save(const std::string& path) const;
+    uint32_t tickCount() const { return ticks; }
+
+private:
+    std::vector<uint8_t> log;
+    uint32_t ticks, changes;
+    uint8_t last;
+    uint32_t lastTick;
+    uint32_t seed, flags;
+};
+
+class ReplayPlayer {
+public:
+    ReplayPlayer();
+
+    bool load(const std::string& path);
+    void rewind();                          // 回到第 0 步
+    bool finished() const { return tick >= header.ticks; }
+    uint8_t peek();                         // 本步输入，不前进
+    uint8_t next();                         // 本步输入，并前进一步
+
+    uint32_t seed() const { return header.seed; }
+    uint32_t flags() const { return header.flags; }
+    uint32_t ticks() const { return header.ticks; }
+    uint32_t position() const { return tick; }
+
+private:
+    void readChange();
+
+    ReplayHeader header;
+    std::vector<uint8_t> log;
+    size_t pos;
+    uint32_t tick, nextChange;  // nextChange：下一条变化生效的步
+    uint8_t current, pending;   // pending：下一条变化的输入位
+    uint32_t changesLeft;       // 尚未生效的变化条数（含 pending）
+};
+
+#endif
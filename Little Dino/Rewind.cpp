@@ -0,0 +1,57 @@
+#include "Rewind.h"
+
+#include "Replay.h"
+
+RewindBuffer::RewindBuffer(size_t capBytes) : base(0), oldestKey(0), keyCount(0), last(0) {
+    size_t n = capBytes / (sizeof(WorldState) + REWIND_KEY_INTERVAL); // 每个关键帧连同其后一段输入
+    if (n < 2) n = 2;
+    keys.resize(n);
+    inputs.resize(n * REWIND_KEY_INTERVAL);
+}
+
+void RewindBuffer::begin(const GameWorld& w) {
+    base = last = w.tick;
+    oldestKey = keyCount = 0;
+    shadow = w.track;
+    TrackSpawn sp[MAX_SPAWNS_PER_TICK];
+    while (shadow.tick < w.tick) shadow.next(sp);
+    writeKey(w);
+}
+
+// 关键帧里的生成器换成同步推进的那份，恢复到不带 feed 的世界时无需快进
+void RewindBuffer::writeKey(const GameWorld& w) {
+    WorldState& k = keys[(oldestKey + keyCount) % keys.size()];
+    w.save(k);
+    k.track = shadow;
+    if (keyCount == keys.size()) ++oldestKey; // 覆盖了最旧的
+    else ++keyCount;
+}
+
+void RewindBuffer::record(const WorldInput& in, const GameWorld& w) {
+    if (keyCount == 0 || w.tick != last + 1) { begin(w); return; } // 中间有没记录的步：从这里重新开始
+    inputs[(last - base) % inputs.size()] = replayBits(in, false);
+    TrackSpawn sp[MAX_SPAWNS_PER_TICK];
+    shadow.next(sp);
+    last = w.tick;
+    if ((last - base) % REWIND_KEY_INTERVAL == 0) writeKey(w);
+}
+
+bool RewindBuffer::seek(uint32_t tick, GameWorld& out) const {
+    if (empty() || tick < firstTick() || tick > last) return false;
+    uint32_t n = (tick - base) / REWIND_KEY_INTERVAL;
+    out.restore(keys[n % keys.size()]);
+    for (uint32_t t = keyTick(n); t < tick; ++t) out.step(replayInput(inputs[(t - base) % inputs.size()]));
+    return true;
+}
+
+void RewindBuffer::truncate(uint32_t tick) {
+    if (empty()) return;
+    if (tick < firstTick()) tick = firstTick();
+    if (tick > last) tick = last;
+    uint32_t n = (tick - base) / REWIND_KEY_INTERVAL;
+    keyCount = n - oldestKey + 1;
+    last = tick;
+    shadow = keys[n % keys.size()].track;
+    TrackSpawn sp[MAX_SPAWNS_PER_TICK];
+    while (shadow.tick < tick) shadow.next(sp);
+}
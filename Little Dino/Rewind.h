@@ -0,0 +1,48 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include <stdint.h>
+#include <vector>
+#include "GameWorld.h"
+
+// ==========================================
+// 回退缓冲：练习模式下死亡后按住 ← 倒回最近十几秒，从任意一步继续。
+// 每 REWIND_KEY_INTERVAL 步存一个关键帧（完整 WorldState），其间每步只存 1 字节输入：
+// 模拟是确定的，输入就是相邻两步之间的全部差异。
+// 定位某一步 = 恢复它之前最近的关键帧 + 重新模拟不到 REWIND_KEY_INTERVAL 步（微秒级）。
+// 关键帧与输入都放在构造时按内存上限分配好的环形缓冲里，写满后覆盖最旧的
+// ==========================================
+const uint32_t REWIND_KEY_INTERVAL = 30;           // 半秒一个关键帧
+const size_t REWIND_MEMORY_CAP = 192 * 1024;       // 约 25 个关键帧，可回退 12 秒以上
+
+class RewindBuffer {
+public:
+    explicit RewindBuffer(size_t capBytes = REWIND_MEMORY_CAP);
+
+    // 从 w 的当前局面开始记录（新局、读档后），丢弃之前的全部历史
+    void begin(const GameWorld& w);
+    // 每步之后调用：in 为这一步的输入，w 为推进后的世界
+    void record(const WorldInput& in, const GameWorld& w);
+    // 把 out 置为第 tick 步的局面（tick 需在 [firstTick, lastTick] 内）；out 不能设置 feed
+    bool seek(uint32_t tick, GameWorld& out) const;
+    // 从第 tick 步继续：丢弃其后的历史
+    void truncate(uint32_t tick);
+
+    bool empty() const { return keyCount == 0; }
+    uint32_t firstTick() const { return keyTick(oldestKey); }
+    uint32_t lastTick() const { return last; }
+    size_t bytes() const { return keys.size() * sizeof(WorldState) + inputs.size(); } // 固定占用
+
+private:
+    uint32_t keyTick(uint32_t n) const { return base + n * REWIND_KEY_INTERVAL; }
+    void writeKey(const GameWorld& w);
+
+    std::vector<WorldState> keys;   // 第 n 个关键帧在 keys[n % keys.size()]
+    std::vector<uint8_t> inputs;    // 第 t 步的输入在 inputs[(t - base) % inputs.size()]
+    uint32_t base;                  // begin 时的步号
+    uint32_t oldestKey, keyCount;   // 仍保存着的关键帧编号范围
+    uint32_t last;                  // 已记录到的步号
+    TrackGenerator shadow;          // 与世界同步推进的生成器：设置了 feed 的世界自己的生成器不前进
+};
+
+#endif
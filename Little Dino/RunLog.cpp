@@ -0,0 +1,205 @@
+#include "RunLog.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <vector>
+#include "SaveFile.h"
+
+static_assert(sizeof(RunRecord) == 32, "run record must have no padding");
+static_assert(sizeof(RunIndex) == 32 + RUNLOG_TOP_N * sizeof(RunRecord), "run index must have no padding");
+
+static uint32_t recordCrc(const RunRecord& r) {
+    return crc32(reinterpret_cast<const unsigned char*>(&r) + sizeof(r.crc), sizeof(RunRecord) - sizeof(r.crc));
+}
+
+static uint32_t indexCrc(const RunIndex& x) {
+    const size_t skip = offsetof(RunIndex, crc) + sizeof(x.crc);
+    return crc32(reinterpret_cast<const unsigned char*>(&x) + skip, sizeof(RunIndex) - skip);
+}
+
+static RunIndex emptyIndex() {
+    RunIndex x;
+    std::memset(&x, 0, sizeof(x));
+    std::memcpy(x.magic, RUNTOP_MAGIC, 4);
+    x.version = RUNLOG_VERSION;
+    return x;
+}
+
+// 读日志头，返回记录区的起点；无效时返回 0。1 版的头只有前 16 字节
+const long RUNLOG_V1_HEADER = (long)offsetof(RunLogHeader, droppedRuns);
+
+static long readHeader(FILE* f, RunLogHeader& h) {
+    std::memset(&h, 0, sizeof(h));
+    if (std::fread(&h, 1, RUNLOG_V1_HEADER, f) != (size_t)RUNLOG_V1_HEADER) return 0;
+    if (std::memcmp(h.magic, RUNLOG_MAGIC, 4) != 0 || h.recordSize != sizeof(RunRecord)) return 0;
+    if (h.version == 1) return RUNLOG_V1_HEADER;
+    size_t rest = sizeof(h) - RUNLOG_V1_HEADER;
+    if (h.version != RUNLOG_VERSION || std::fread(reinterpret_cast<char*>(&h) + RUNLOG_V1_HEADER, 1, rest, f) != rest) return 0;
+    return (long)sizeof(h);
+}
+
+// 同分时先到的在前，与压缩时的排序一致
+static bool higherScore(const RunRecord& a, const RunRecord& b) { return a.score > b.score; }
+
+// ==========================================
+// Leaderboard
+// ==========================================
+
+Leaderboard::Leaderboard() : idx(emptyIndex()) {}
+
+void Leaderboard::add(const RunRecord& r) {
+    ++idx.totalRuns;
+    if (r.coins > idx.bestCoins) idx.bestCoins = r.coins;
+    unsigned pos = 0;
+    while (pos < idx.count && idx.top[pos].score >= r.score) ++pos;
+    if (pos >= (unsigned)RUNLOG_TOP_N) return;
+    if (idx.count < (unsigned)RUNLOG_TOP_N) ++idx.count;
+    for (unsigned i = idx.count - 1; i > pos; --i) idx.top[i] = idx.top[i - 1];
+    idx.top[pos] = r;
+}
+
+bool Leaderboard::load(RunLogWriter& writer, RunRecord& legacy) {
+    idx = emptyIndex();
+    writer = RunLogWriter();
+
+    FILE* f = std::fopen(RUNLOG_FILE, "rb");
+    RunLogHeader h;
+    uint32_t n = 0;
+    long start = f ? readHeader(f, h) : 0;
+    bool logOk = start > 0 && std::fseek(f, 0, SEEK_END) == 0;
+    if (logOk) {
+        long bytes = std::ftell(f) - start;
+        n = (uint32_t)(bytes / (long)sizeof(RunRecord));
+        writer.generation = h.generation;
+        writer.droppedRuns = h.droppedRuns;
+        writer.records = n;
+        writer.rewrite = bytes % (long)sizeof(RunRecord) != 0 || h.version != RUNLOG_VERSION; // 残缺尾部（追加到一半时断电）或旧版日志
+        idx.totalRuns = h.droppedRuns; // 索引失效、从头扫描时的起点
+    } else {
+        writer.generation = (uint32_t)std::time(0); // 新建的日志不会与残留的旧索引同代号
+    }
+
+    // 索引有效时只需读它之后的尾部
+    RunIndex top;
+    uint32_t from = 0;
+    std::ifstream in(RUNTOP_FILE, std::ios::binary);
+    if (logOk && in.read(reinterpret_cast<char*>(&top), sizeof(top)) && std::memcmp(top.magic, RUNTOP_MAGIC, 4) == 0
+        && top.version == RUNLOG_VERSION && top.crc == indexCrc(top) && top.generation == h.generation
+        && top.logRecords <= n && top.count <= (uint32_t)RUNLOG_TOP_N) {
+        idx = top;
+        from = top.logRecords;
+        writer.indexed = top.logRecords;
+    }
+    if (logOk && from < n && std::fseek(f, start + (long)(from * sizeof(RunRecord)), SEEK_SET) == 0) {
+        RunRecord buf[256];
+        size_t got;
+        while ((got = std::fread(buf, sizeof(RunRecord), 256, f)) > 0) {
+            for (size_t i = 0; i < got; ++i) {
+                if (buf[i].crc == recordCrc(buf[i])) add(buf[i]);
+                else { ++idx.totalRuns; writer.rewrite = true; } // 损坏的记录仍算一局，压缩时丢弃并计入 droppedRuns
+            }
+        }
+    }
+    if (f) std::fclose(f);
+    if (logOk) return false;
+
+    // 还没有战绩日志：沿用旧 highscore.dat（两个整数）里的最高分
+    std::ifstream old("highscore.dat");
+    int hs = 0, hc = 0;
+    if (!(old >> hs >> hc) || (hs <= 0 && hc <= 0)) return false;
+    std::memset(&legacy, 0, sizeof(legacy));
+    legacy.score = hs;
+    legacy.coins = hc;
+    legacy.killer = -1;
+    add(legacy);
+    return true;
+}
+
+// ==========================================
+// RunLogWriter
+// ==========================================
+
+bool RunLogWriter::append(const RunRecord& r, const RunIndex& board) {
+    RunRecord rec = r;
+    rec.crc = recordCrc(rec);
+    pending.push_back(rec);
+    if (rewrite || records >= RUNLOG_COMPACT_AT) return compact(board);
+    FILE* f = std::fopen(RUNLOG_FILE, "ab");
+    if (!f) { rewrite = true; return false; }
+    bool ok = std::fwrite(&rec, 1, sizeof(rec), f) == sizeof(rec) && syncFile(f);
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok) { rewrite = true; return false; } // 可能留下了半条记录
+    pending.clear();
+    ++records;
+    if (records - indexed >= RUNLOG_INDEX_EVERY) writeIndex(board);
+    return true;
+}
+
+bool RunLogWriter::writeIndex(RunIndex board) {
+    board.generation = generation;
+    board.logRecords = records;
+    board.crc = indexCrc(board);
+    if (!writeFileAtomic(RUNTOP_FILE, &board, sizeof(board))) return false;
+    indexed = records;
+    return true;
+}
+
+// 读出全部有效记录并补上未写入的，保留排行榜上的、金币最多的与最近 RUNLOG_KEEP_RECENT 条（按原顺序），整体重写
+bool RunLogWriter::compact(RunIndex board) {
+    std::vector<RunRecord> all;
+    uint32_t damaged = 0; // 校验失败的完整记录：内容丢了，但局数仍要计入累计
+    FILE* f = std::fopen(RUNLOG_FILE, "rb");
+    RunLogHeader h;
+    if (f && readHeader(f, h) > 0) {
+        RunRecord buf[256];
+        size_t got;
+        while ((got = std::fread(buf, sizeof(RunRecord), 256, f)) > 0)
+            for (size_t i = 0; i < got; ++i) {
+                if (buf[i].crc == recordCrc(buf[i])) all.push_back(buf[i]);
+                else ++damaged;
+            }
+    }
+    if (f) std::fclose(f);
+    all.insert(all.end(), pending.begin(), pending.end());
+
+    std::vector<bool> keep(all.size(), false);
+    size_t recent = all.size() > RUNLOG_KEEP_RECENT ? all.size() - RUNLOG_KEEP_RECENT : 0;
+    for (size_t i = recent; i < all.size(); ++i) keep[i] = true;
+    std::vector<size_t> order(all.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&all](size_t a, size_t b) { return higherScore(all[a], all[b]); });
+    for (size_t i = 0; i < order.size() && i < (size_t)RUNLOG_TOP_N; ++i) keep[order[i]] = true;
+    size_t most = 0; // 金币纪录可能不在前 N 名里，保留它，重建时 bestCoins 不变
+    for (size_t i = 1; i < all.size(); ++i) if (all[i].coins > all[most].coins) most = i;
+    if (!all.empty()) keep[most] = true;
+
+    std::vector<unsigned char> out(sizeof(RunLogHeader));
+    RunLogHeader nh;
+    std::memcpy(nh.magic, RUNLOG_MAGIC, 4);
+    nh.version = RUNLOG_VERSION;
+    nh.generation = generation + 1;
+    nh.recordSize = sizeof(RunRecord);
+    nh.droppedRuns = droppedRuns + damaged;
+    nh.reserved = 0;
+    for (size_t i = 0; i < all.size(); ++i) if (!keep[i]) ++nh.droppedRuns;
+    std::memcpy(out.data(), &nh, sizeof(nh));
+    uint32_t kept = 0;
+    for (size_t i = 0; i < all.size(); ++i) {
+        if (!keep[i]) continue;
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(&all[i]);
+        out.insert(out.end(), p, p + sizeof(RunRecord));
+        ++kept;
+    }
+    if (!writeFileAtomic(RUNLOG_FILE, out.data(), out.size())) return false; // pending 留到下次
+    generation = nh.generation;
+    droppedRuns = nh.droppedRuns;
+    records = kept;
+    rewrite = false;
+    pending.clear();
+    writeIndex(board); // 新代号的日志需要新索引，否则下次启动要整体扫描
+    return true;
+}
@@ -0,0 +1,97 @@
+#ifndef RUNLOG_H
+#define RUNLOG_H
+
+#include <stdint.h>
+#include <vector>
+
+// ==========================================
+// 战绩记录：runs.log 只追加，每局结束写一条定长记录（分数、金币、时长、死因、种子），
+// 结算时只有一次 32 字节的写入。
+// 排行榜（前 RUNLOG_TOP_N 名与累计数据）另存在定长的 runs.top 里，启动时读它，
+// 再补上它之后追加的少量记录（不超过 RUNLOG_INDEX_EVERY 条），与日志长度无关。
+// 日志过长或尾部残缺时压缩：只保留排行榜上的、金币最多的与最近的记录，被丢掉的局数累加进日志头，
+// 整体重写后换代号；代号与日志不符的索引视为失效，退回扫描整个日志重建，累计数据不丢
+// ==========================================
+const char RUNLOG_MAGIC[4] = { 'D', 'R', 'U', 'N' };
+const char RUNTOP_MAGIC[4] = { 'D', 'T', 'O', 'P' };
+const uint32_t RUNLOG_VERSION = 2;         // 2：日志头增加 droppedRuns；1 版日志仍可读，下次写入时压缩成 2 版
+const char* const RUNLOG_FILE = "runs.log";
+const char* const RUNTOP_FILE = "runs.top";
+const int RUNLOG_TOP_N = 10;
+const uint32_t RUNLOG_INDEX_EVERY = 64;     // 索引落后日志这么多条时重写索引
+const uint32_t RUNLOG_COMPACT_AT = 8192;    // 日志达到这么多条时压缩
+const uint32_t RUNLOG_KEEP_RECENT = 1024;   // 压缩后保留的最近记录
+
+struct RunLogHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t generation;    // 每次整体重写加一
+    uint32_t recordSize;    // sizeof(RunRecord)
+    uint32_t droppedRuns;   // 历次压缩丢掉的局数，计入累计局数（1 版没有，按 0）
+    uint32_t reserved;
+};
+
+struct RunRecord {
+    uint32_t crc;           // 其后全部字节的 CRC-32，写入时填
+    uint32_t seed;
+    int64_t endedAt;        // time(0)
+    int32_t score;
+    int32_t coins;
+    uint32_t ticks;         // 时长（模拟步数）
+    int32_t killer;         // 撞上的 SpriteId；-1 为从旧 highscore.dat 迁移来的成绩
+};
+
+// runs.top 的全部内容
+struct RunIndex {
+    char magic[4];
+    uint32_t version;
+    uint32_t crc;           // 其后全部字节的 CRC-32
+    uint32_t generation;    // 与日志头相同才有效
+    uint32_t logRecords;    // 已计入的日志记录数，之后的是尾部
+    uint32_t totalRuns;     // 累计局数（压缩后日志里不再全部保留）
+    int32_t bestCoins;      // 单局最多金币，可能不在前 N 名里
+    uint32_t count;         // top 中有效的条数
+    RunRecord top[RUNLOG_TOP_N]; // 按分数从高到低，同分先到的在前
+};
+
+// 工作线程：追加、重写索引、压缩；只在一个线程上使用
+class RunLogWriter {
+public:
+    RunLogWriter() : records(0), indexed(0), generation(0), droppedRuns(0), rewrite(true) {}
+
+    // 追加一局；board 为已计入这一局的排行榜。
+    // 写入失败时记录留在内存里，下次追加时连同新记录一起整体重写，排行榜与日志最终一致
+    bool append(const RunRecord& r, const RunIndex& board);
+
+private:
+    friend class Leaderboard;
+    bool compact(RunIndex board);
+    bool writeIndex(RunIndex board);
+
+    uint32_t records;       // 日志中的记录数
+    uint32_t indexed;       // runs.top 计入到第几条
+    uint32_t generation;
+    uint32_t droppedRuns;   // 同日志头
+    bool rewrite;           // 日志不存在、头部不符、尾部残缺或有未写入的记录：下次追加改为整体重写
+    std::vector<RunRecord> pending; // 已计入排行榜、还没写进日志的记录（带 CRC）
+};
+
+// 帧线程：内存里的排行榜
+class Leaderboard {
+public:
+    Leaderboard();
+
+    // 启动时调用（在 writer 开始工作之前），同时把日志现状交给 writer。
+    // 没有任何战绩但有旧 highscore.dat 时，其成绩计入排行榜并放在 legacy 里、返回 true，由调用方写进日志
+    bool load(RunLogWriter& writer, RunRecord& legacy);
+    void add(const RunRecord& r);
+
+    const RunIndex& index() const { return idx; }
+    int bestScore() const { return idx.count ? idx.top[0].score : 0; }
+    int bestCoins() const { return idx.bestCoins; }
+
+private:
+    RunIndex idx;
+};
+
+#endif
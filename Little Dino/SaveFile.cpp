@@ -0,0 +1,183 @@
+#include "SaveFile.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+struct Crc32Table {
+    uint32_t t[256];
+    Crc32Table() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+    }
+};
+
+uint32_t crc32(const void* data, size_t len) {
+    static const Crc32Table table;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; ++i) c = table.t[(c ^ p[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+bool syncFile(FILE* f) {
+    if (std::fflush(f) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+// 刷到磁盘后再改名：改名之前崩溃只会留下临时文件，旧文件完好
+bool writeFileAtomic(const std::string& path, const void* data, size_t len) {
+    std::string tmp = path + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(data, 1, len, f) == len && syncFile(f);
+    ok = std::fclose(f) == 0 && ok;
+    if (ok) {
+#ifdef _WIN32
+        ok = MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        ok = std::rename(tmp.c_str(), path.c_str()) == 0;
+#endif
+    }
+    if (!ok) std::remove(tmp.c_str());
+    return ok;
+}
+
+bool writeSave(const std::string& path, const WorldState& state) {
+    struct {
+        SaveHeader h;
+        WorldState s;
+    } file;
+    static_assert(sizeof(file) == sizeof(SaveHeader) + sizeof(WorldState), "save layout must have no padding");
+    file.s = state;
+    TrackSpawn sp[MAX_SPAWNS_PER_TICK];
+    while (file.s.track.tick < file.s.tick) file.s.track.next(sp); // 读档时直接从当前步接着生成
+
+    std::memcpy(file.h.magic, SAVE_MAGIC, 4);
+    file.h.version = SAVE_VERSION;
+    file.h.stateSize = sizeof(WorldState);
+    file.h.crc = crc32(&file.s, sizeof(WorldState));
+    return writeFileAtomic(path, &file, sizeof(file));
+}
+
+static bool validList(const EntityList& l, int maxType) {
+    if (l.size() > ENTITY_CAPACITY) return false;
+    for (unsigned i = 0; i < l.size(); ++i) {
+        unsigned s = l.slot(i);
+        if (!std::isfinite(l.x[s]) || !std::isfinite(l.y[s]) || !std::isfinite(l.prevX[s]) || l.type[s] > maxType || l.flag[s] > 1) return false;
+    }
+    return true;
+}
+
+// 文件里的 bool 只能是 0 或 1，其他值按 bool 读取是未定义行为，先按字节看
+static bool validBool(const bool& b) {
+    unsigned char c;
+    std::memcpy(&c, &b, 1);
+    return c <= 1;
+}
+
+bool validWorldState(const WorldState& s) {
+    if (!std::isfinite(s.dist) || !std::isfinite(s.spd) || !std::isfinite(s.groundX[0]) || !std::isfinite(s.groundX[1]) || !std::isfinite(s.lastScroll)) return false;
+    if (!std::isfinite(s.dino.y) || !std::isfinite(s.dino.prevY) || !std::isfinite(s.dino.vy) || !std::isfinite(s.dino.startY)) return false;
+    if (!validBool(s.dino.onGround) || !validBool(s.dino.showRun1)) return false;
+    if (s.killer < -1 || s.killer >= SPR_COUNT || s.coins < 0) return false;
+    if (!validList(s.cacti, 2) || !validList(s.coinList, 0) || !validList(s.birds, 0)) return false;
+    return s.track.valid() && s.track.tick <= s.tick;
+}
+
+bool readSave(const std::string& path, GameWorld& w) {
+    unsigned char buf[sizeof(SaveHeader) + sizeof(WorldState) + 1]; // 多读 1 字节，用来发现多余的尾部
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    size_t n = std::fread(buf, 1, sizeof(buf), f);
+    std::fclose(f);
+    if (n != sizeof(SaveHeader) + sizeof(WorldState)) return false;
+
+    SaveHeader h;
+    std::memcpy(&h, buf, sizeof(h));
+    if (std::memcmp(h.magic, SAVE_MAGIC, 4) != 0 || h.version != SAVE_VERSION || h.stateSize != sizeof(WorldState)) return false;
+    WorldState s;
+    std::memcpy(&s, buf + sizeof(h), sizeof(WorldState));
+    if (crc32(&s, sizeof(WorldState)) != h.crc || !validWorldState(s)) return false;
+
+    w.restore(s);
+    return true;
+}
+
+std::string slotPath(int slot) {
+    std::ostringstream out;
+    out << "save" << slot + 1 << ".dat";
+    return out.str();
+}
+
+static_assert(sizeof(SlotInfo) == 24 + SLOT_THUMB_W * SLOT_THUMB_H, "slot info must have no padding");
+const size_t SLOT_INDEX_SIZE = sizeof(SlotIndexHeader) + SAVE_SLOTS * sizeof(SlotInfo);
+
+static uint32_t slotCrc(const SlotInfo& info) {
+    return crc32(reinterpret_cast<const unsigned char*>(&info) + sizeof(info.crc), sizeof(SlotInfo) - sizeof(info.crc));
+}
+
+static bool validIndexHeader(const void* p) {
+    SlotIndexHeader h;
+    std::memcpy(&h, p, sizeof(h));
+    return std::memcmp(h.magic, SLOT_INDEX_MAGIC, 4) == 0 && h.version == SLOT_INDEX_VERSION && h.slots == (uint32_t)SAVE_SLOTS && h.infoSize == sizeof(SlotInfo);
+}
+
+// 空索引：文件头 + 全零记录
+static bool createIndex() {
+    std::vector<unsigned char> blank(SLOT_INDEX_SIZE, 0);
+    SlotIndexHeader h;
+    std::memcpy(h.magic, SLOT_INDEX_MAGIC, 4);
+    h.version = SLOT_INDEX_VERSION;
+    h.slots = SAVE_SLOTS;
+    h.infoSize = sizeof(SlotInfo);
+    std::memcpy(blank.data(), &h, sizeof(h));
+    return writeFileAtomic(SLOT_INDEX_FILE, blank.data(), blank.size());
+}
+
+bool writeSlotInfo(int slot, SlotInfo info) {
+    if (slot < 0 || slot >= SAVE_SLOTS) return false;
+    info.crc = slotCrc(info);
+    FILE* f = std::fopen(SLOT_INDEX_FILE, "r+b");
+    unsigned char head[sizeof(SlotIndexHeader)];
+    bool valid = f && std::fread(head, 1, sizeof(head), f) == sizeof(head) && validIndexHeader(head)
+              && std::fseek(f, 0, SEEK_END) == 0 && std::ftell(f) == (long)SLOT_INDEX_SIZE;
+    if (!valid) { // 帧线程只映射格式正确的索引，所以这里整体替换不会撞上映射
+        if (f) std::fclose(f);
+        if (!createIndex()) return false;
+        f = std::fopen(SLOT_INDEX_FILE, "r+b");
+        if (!f) return false;
+    }
+    bool ok = std::fseek(f, (long)(sizeof(SlotIndexHeader) + slot * sizeof(SlotInfo)), SEEK_SET) == 0
+           && std::fwrite(&info, 1, sizeof(info), f) == sizeof(info) && syncFile(f);
+    ok = std::fclose(f) == 0 && ok;
+    return ok;
+}
+
+bool SlotIndex::open() {
+    if (!file.open(SLOT_INDEX_FILE)) return false;
+    if (file.size() != SLOT_INDEX_SIZE || !validIndexHeader(file.data())) { file.close(); return false; }
+    return true;
+}
+
+bool SlotIndex::read(int slot, SlotInfo& out) const {
+    if (!file.isOpen() || slot < 0 || slot >= SAVE_SLOTS) return false;
+    std::memcpy(&out, file.data() + sizeof(SlotIndexHeader) + slot * sizeof(SlotInfo), sizeof(SlotInfo));
+    return out.used && slotCrc(out) == out.crc;
+}
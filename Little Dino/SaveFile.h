@@ -0,0 +1,85 @@
+#ifndef SAVEFILE_H
+#define SAVEFILE_H
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include "GameWorld.h"
+#include "MappedFile.h"
+
+// ==========================================
+// 存档：定长二进制，SaveHeader | WorldState（原样字节）
+// 世界状态整块写入（含速度、生成器与随机数、翅膀相位），读档后从存档的那一步原样继续。
+// 写入先落到临时文件并刷到磁盘，再改名覆盖，中途崩溃不会留下半个存档；
+// 读取一次读完整个文件，校验长度、版本、CRC 与各字段范围，任何一项不符都不改动世界
+// ==========================================
+const char SAVE_MAGIC[4] = { 'D', 'S', 'A', 'V' };
+const uint32_t SAVE_VERSION = 1;
+const int SAVE_SLOTS = 4;
+
+struct SaveHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t stateSize;     // sizeof(WorldState)：编译器/平台布局不同的存档直接拒绝
+    uint32_t crc;           // WorldState 字节的 CRC-32
+};
+
+uint32_t crc32(const void* data, size_t len);
+bool syncFile(FILE* f);     // fflush 并刷到磁盘
+// 写入 path.tmp、刷到磁盘后改名覆盖 path；高分文件也用它
+bool writeFileAtomic(const std::string& path, const void* data, size_t len);
+
+// 字段范围检查：CRC 只防损坏，这里保证即使内容被改过也不会越界访问
+bool validWorldState(const WorldState& s);
+
+// s 一般来自 GameWorld::save；设置了 feed 的世界生成器落后于当前步，写入前会先追上
+bool writeSave(const std::string& path, const WorldState& s);
+// 成功时 w 恢复到存档局面（赛道接着生成）；失败时 w 不变
+bool readSave(const std::string& path, GameWorld& w);
+
+std::string slotPath(int slot); // 第 slot 个存档位的文件：save1.dat ...
+
+// ==========================================
+// 存档位索引 saves.idx：定长文件，SlotIndexHeader | SlotInfo x SAVE_SLOTS。
+// 每个存档位一条元数据（距离、金币、时间、存档时的缩略图），读档菜单只映射这一个文件，
+// 不打开也不解析各存档位文件；确认读取时才读对应的存档。
+// 写入就地覆盖单条记录（映射着的文件不能被改名替换），每条带 CRC，写到一半的记录显示为空位
+// ==========================================
+const char SLOT_INDEX_MAGIC[4] = { 'D', 'I', 'D', 'X' };
+const uint32_t SLOT_INDEX_VERSION = 1;
+const char* const SLOT_INDEX_FILE = "saves.idx";
+const int SLOT_THUMB_W = 64;
+const int SLOT_THUMB_H = 32;
+
+struct SlotIndexHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t slots;         // SAVE_SLOTS
+    uint32_t infoSize;      // sizeof(SlotInfo)
+};
+
+struct SlotInfo {
+    uint32_t crc;           // 其后全部字节的 CRC-32；全零记录为空位
+    uint32_t used;
+    int64_t savedAt;        // time(0)
+    float dist;
+    int32_t coins;
+    uint8_t thumb[SLOT_THUMB_W * SLOT_THUMB_H]; // 灰度观测帧（ObsFrame.h），行主序
+};
+
+// 后台线程调用：写入第 slot 条记录并刷到磁盘（文件不存在或格式不符时先重建）
+bool writeSlotInfo(int slot, SlotInfo info);
+
+// 帧线程只读映射索引；open 失败（没有存过档）时各存档位都是空的
+class SlotIndex {
+public:
+    bool open();
+    void close() { file.close(); }
+    // 复制第 slot 条记录；空位或校验失败时返回 false
+    bool read(int slot, SlotInfo& out) const;
+
+private:
+    MappedFile file;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "SimTools.h"
+
+#include "Bundle.h"
+
+bool loadMasks(const std::string& path, SpriteMetrics& m, PixelMask* masks) {
+    AssetBundle pak;
+    if (!pak.open(path)) return false;
+    for (int i = 0; i < SPR_COUNT; ++i) {
+        const BundleEntry* e = pak.find(SPRITE_FILES[i]);
+        if (!e || e->kind != BUNDLE_RGBA) return false;
+    }
+    for (int i = 0; i < SPR_COUNT; ++i) {
+        const BundleEntry* e = pak.find(SPRITE_FILES[i]);
+        masks[i].build(pak.data(*e), (int)e->width, (int)e->height);
+        m.w[i] = (int)e->width; m.h[i] = (int)e->height;
+    }
+    return true;
+}
+
+bool parsePolicy(const std::string& name, Policy& out) {
+    if (name == "none") out = POLICY_NONE;
+    else if (name == "random") out = POLICY_RANDOM;
+    else if (name == "react") out = POLICY_REACT;
+    else if (name == "search") out = POLICY_SEARCH;
+    else return false;
+    return true;
+}
+
+const char* policyName(Policy p) {
+    switch (p) {
+    case POLICY_NONE: return "none";
+    case POLICY_RANDOM: return "random";
+    case POLICY_SEARCH: return "search";
+    default: return "react";
+    }
+}
+
+// 简单的反应式策略：仙人掌进入跳跃距离就起跳；飞鸟高于站立的恐龙，不跳即可躲过。
+// 跳起后鸟会在落地前飞到恐龙这里时，等起跳距离内的仙人掌都越过了就加速下落，从鸟下穿过
+static WorldInput reactPolicy(const GameWorld& w) {
+    WorldInput in;
+    float reach = 60.0f + w.spd * 12.0f; // 速度越快越早起跳
+    float dw = (float)w.metrics.w[SPR_DINO_RUN1];
+    for (unsigned i = 0; i < w.cacti.size(); ++i) {
+        float dx = w.cacti.x[w.cacti.slot(i)] - DINO_X;
+        if (dx > 0 && dx < reach) in.jump = true;
+    }
+    if (w.dino.onGround) return in;
+
+    float air = w.spd * (-2.0f * JUMP_FORCE / GRAVITY); // 一次完整跳跃期间滚过的距离
+    bool birdAhead = false, cactusNear = false;
+    for (unsigned i = 0; i < w.birds.size(); ++i) {
+        float dx = w.birds.x[w.birds.slot(i)] - DINO_X;
+        if (dx > -w.metrics.w[SPR_BIRD_UP] && dx < air + dw) birdAhead = true;
+    }
+    for (unsigned i = 0; i < w.cacti.size(); ++i) {
+        unsigned s = w.cacti.slot(i);
+        float dx = w.cacti.x[s] - DINO_X;
+        if (dx > -w.metrics.w[SPR_CACTUS_L + w.cacti.type[s]] && dx < reach) cactusNear = true;
+    }
+    in.fastFall = birdAhead && !cactusNear;
+    return in;
+}
+
+void ScriptedPlayer::reset(uint32_t seed) {
+    rng.seed(seed);
+    bot.reset();
+}
+
+WorldInput ScriptedPlayer::input(const GameWorld& w) {
+    WorldInput in;
+    if (policy == POLICY_RANDOM) in.jump = (rng.nextInt(30) == 0);
+    else if (policy == POLICY_REACT) in = reactPolicy(w);
+    else if (policy == POLICY_SEARCH) in = bot.think(w);
+    return in;
+}
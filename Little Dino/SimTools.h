@@ -0,0 +1,32 @@
+#ifndef SIMTOOLS_H
+#define SIMTOOLS_H
+
+#include <string>
+#include "Bot.h"
+#include "GameWorld.h"
+
+// ==========================================
+// 无头工具共用：碰撞位图加载与脚本玩家（headless / tuner）
+// ==========================================
+
+// 从资源包的 RGBA 条目生成碰撞位图，同时以真实贴图尺寸覆盖默认值；缺任何一张都返回 false
+bool loadMasks(const std::string& path, SpriteMetrics& m, PixelMask* masks);
+
+enum Policy { POLICY_NONE, POLICY_RANDOM, POLICY_REACT, POLICY_SEARCH };
+
+bool parsePolicy(const std::string& name, Policy& out);
+const char* policyName(Policy p);
+
+// 脚本玩家：策略加上它自己的随机数流 / 搜索状态，多线程下每个线程各用一个
+struct ScriptedPlayer {
+    Policy policy;
+    WorldRng rng;       // random 策略用
+    SearchBot bot;      // search 策略用
+
+    explicit ScriptedPlayer(Policy p) : policy(p) { rng.seed(0); }
+
+    void reset(uint32_t seed);                  // 新的一局
+    WorldInput input(const GameWorld& w);       // 本步输入
+};
+
+#endif
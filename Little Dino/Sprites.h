@@ -0,0 +1,34 @@
+#ifndef SPRITES_H
+#define SPRITES_H
+
+// ==========================================
+// 精灵编号与资源文件（渲染与模拟共用，不依赖 SFML）
+// ==========================================
+enum SpriteId {
+    SPR_DINO_RUN1, SPR_DINO_RUN2, SPR_DINO_JUMP,
+    SPR_CACTUS_L, SPR_CACTUS_S1, SPR_CACTUS_S2,
+    SPR_COIN, SPR_TRACK, SPR_BIRD_UP, SPR_BIRD_DOWN,
+    SPR_COUNT
+};
+
+const char* const SPRITE_FILES[SPR_COUNT] = {
+    "DinoRun1.png", "DinoRun2.png", "DinoJump.png",
+    "LargeCactus1.png", "SmallCactus1.png", "SmallCactus2.png",
+    "Coin.png", "Track.png", "BirdWingUp.png", "BirdWingDown.png"
+};
+
+// 精灵像素尺寸：碰撞框与落地高度都由它决定
+struct SpriteMetrics {
+    int w[SPR_COUNT], h[SPR_COUNT];
+};
+
+// 随游戏发布的贴图尺寸，供没有加载贴图的无头模式使用
+inline SpriteMetrics defaultSpriteMetrics() {
+    static const int W[SPR_COUNT] = { 87, 88, 88, 48, 34, 68, 73, 2404, 92, 92 };
+    static const int H[SPR_COUNT] = { 94, 94, 94, 95, 71, 71, 77, 28, 58, 77 };
+    SpriteMetrics m;
+    for (int i = 0; i < SPR_COUNT; ++i) { m.w[i] = W[i]; m.h[i] = H[i]; }
+    return m;
+}
+
+#endif
@@ -0,0 +1,184 @@
+#include "Synth.h"
+
+#include <cstring>
+
+namespace {
+
+struct SynthNote {
+    SynthWave wave;
+    float f0, f1;      // 起止频率 (Hz)
+    float start, dur;  // 秒
+    float attack;      // 起音时长 (秒)，0 表示无包络（保持原始波形）
+    float gain;
+};
+
+struct SynthEffect {
+    const char* name;
+    const SynthNote* notes;
+    unsigned count;
+};
+
+const SynthNote SHUTDOWN_NOTES[] = {
+    { WAVE_SINE, 440.0f, 440.0f, 0.0f, 0.5f, 0.0f, 10000.0f / 32767.0f }
+};
+const SynthNote COIN_NOTES[] = {
+    { WAVE_SQUARE, 988.0f, 988.0f, 0.0f, 0.06f, 0.002f, 0.20f },
+    { WAVE_SQUARE, 1319.0f, 1319.0f, 0.06f, 0.22f, 0.002f, 0.20f }
+};
+const SynthNote JUMP_NOTES[] = {
+    { WAVE_SQUARE, 300.0f, 720.0f, 0.0f, 0.14f, 0.004f, 0.15f }
+};
+const SynthNote MILESTONE_NOTES[] = {
+    { WAVE_TRIANGLE, 523.0f, 523.0f, 0.00f, 0.09f, 0.003f, 0.35f },
+    { WAVE_TRIANGLE, 659.0f, 659.0f, 0.08f, 0.09f, 0.003f, 0.35f },
+    { WAVE_TRIANGLE, 784.0f, 784.0f, 0.16f, 0.09f, 0.003f, 0.35f },
+    { WAVE_TRIANGLE, 1047.0f, 1047.0f, 0.24f, 0.25f, 0.003f, 0.35f }
+};
+
+const SynthEffect EFFECTS[SFX_COUNT] = {
+    { "shutdown", SHUTDOWN_NOTES, sizeof(SHUTDOWN_NOTES) / sizeof(SynthNote) },
+    { "coin", COIN_NOTES, sizeof(COIN_NOTES) / sizeof(SynthNote) },
+    { "jump", JUMP_NOTES, sizeof(JUMP_NOTES) / sizeof(SynthNote) },
+    { "milestone", MILESTONE_NOTES, sizeof(MILESTONE_NOTES) / sizeof(SynthNote) }
+};
+
+unsigned roundUpBlock(unsigned n) { return (n + SYNTH_BLOCK - 1) / SYNTH_BLOCK * SYNTH_BLOCK; }
+
+// 多项式正弦近似（输入为 [0,1) 周期相位），最大误差约 0.1%，避免逐样本调用 sin()
+inline float sinCycle(float p) {
+    float x = p < 0.5f ? p : p - 1.0f;        // [-0.5, 0.5)
+    float y = 8.0f * x - 16.0f * x * (x < 0.0f ? -x : x);
+    return 0.225f * (y * (y < 0.0f ? -y : y) - y) + y;
+}
+
+} // namespace
+
+const char* sfxName(SfxId id) { return EFFECTS[id].name; }
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SYNTH_SSE2 1
+#include <emmintrin.h>
+
+// SSE2 版本：每次处理 4 个采样
+static inline __m128 fracPs(__m128 x) { return _mm_sub_ps(x, _mm_cvtepi32_ps(_mm_cvttps_epi32(x))); }
+static inline __m128 absPs(__m128 x) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), x); }
+
+static inline __m128 sinCyclePs(__m128 p) {
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 x = _mm_sub_ps(p, _mm_and_ps(_mm_cmpge_ps(p, _mm_set1_ps(0.5f)), one));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(8.0f), x), _mm_mul_ps(_mm_set1_ps(16.0f), _mm_mul_ps(x, absPs(x))));
+    __m128 t = _mm_sub_ps(_mm_mul_ps(y, absPs(y)), y);
+    return _mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.225f), t), y);
+}
+#endif
+
+void synthOscillator(float* out, unsigned n, SynthWave wave, float f0, float f1) {
+    // 相位 = f0*t + (f1-f0)*t^2/(2T)，单位为周期；闭式计算，样本之间没有依赖
+    const float inc = f0 / SYNTH_SAMPLE_RATE;
+    const float k = n > 0 ? (f1 - f0) / SYNTH_SAMPLE_RATE / (2.0f * n) : 0.0f;
+#ifdef SYNTH_SSE2
+    const __m128 vinc = _mm_set1_ps(inc), vk = _mm_set1_ps(k), half = _mm_set1_ps(0.5f), one = _mm_set1_ps(1.0f);
+    __m128 i = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 step = _mm_set1_ps(4.0f);
+    for (unsigned b = 0; b < n; b += 4, i = _mm_add_ps(i, step)) {
+        __m128 ph = fracPs(_mm_add_ps(_mm_mul_ps(i, vinc), _mm_mul_ps(_mm_mul_ps(i, i), vk)));
+        __m128 v;
+        if (wave == WAVE_SINE) v = sinCyclePs(ph);
+        else if (wave == WAVE_SQUARE) { // ph < 0.5 ? 1 : -1
+            __m128 lo = _mm_cmplt_ps(ph, half);
+            v = _mm_or_ps(_mm_and_ps(lo, one), _mm_andnot_ps(lo, _mm_set1_ps(-1.0f)));
+        }
+        else v = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(4.0f), _mm_min_ps(ph, _mm_sub_ps(one, ph))), one);
+        _mm_storeu_ps(out + b, v);
+    }
+#else
+    for (unsigned b = 0; b < n; ++b) {
+        float i = (float)b;
+        float ph = i * inc + i * i * k;
+        ph -= (float)(int)ph;
+        if (wave == WAVE_SINE) out[b] = sinCycle(ph);
+        else if (wave == WAVE_SQUARE) out[b] = ph < 0.5f ? 1.0f : -1.0f;
+        else out[b] = 4.0f * (ph < 0.5f ? ph : 1.0f - ph) - 1.0f;
+    }
+#endif
+}
+
+void synthEnvelope(float* buf, unsigned n, unsigned attack, float gain) {
+    // 三角形包络：min(起音斜坡, 衰减斜坡)，截断到 [0,1]；attack 为 0 时只乘增益
+    const float up = attack > 0 ? 1.0f / attack : 0.0f;
+    const float down = attack > 0 && n > attack ? 1.0f / (n - attack) : 0.0f;
+    const float peak = (float)attack;
+#ifdef SYNTH_SSE2
+    const __m128 vup = _mm_set1_ps(up), vdown = _mm_set1_ps(down), vpeak = _mm_set1_ps(peak);
+    const __m128 vgain = _mm_set1_ps(gain), zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+    __m128 i = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 step = _mm_set1_ps(4.0f);
+    for (unsigned b = 0; b < n; b += 4, i = _mm_add_ps(i, step)) {
+        __m128 e = one;
+        if (attack > 0) {
+            __m128 a = _mm_mul_ps(i, vup);
+            __m128 d = _mm_sub_ps(one, _mm_mul_ps(_mm_sub_ps(i, vpeak), vdown));
+            e = _mm_min_ps(one, _mm_max_ps(zero, _mm_min_ps(a, d)));
+        }
+        _mm_storeu_ps(buf + b, _mm_mul_ps(_mm_loadu_ps(buf + b), _mm_mul_ps(e, vgain)));
+    }
+#else
+    for (unsigned b = 0; b < n; ++b) {
+        float e = 1.0f;
+        if (attack > 0) {
+            float i = (float)b, a = i * up, d = 1.0f - (i - peak) * down;
+            e = a < d ? a : d;
+            e = e < 0.0f ? 0.0f : (e > 1.0f ? 1.0f : e);
+        }
+        buf[b] *= e * gain;
+    }
+#endif
+}
+
+void synthMix(float* dst, const float* src, unsigned n) {
+#ifdef SYNTH_SSE2
+    for (unsigned b = 0; b < n; b += 4) _mm_storeu_ps(dst + b, _mm_add_ps(_mm_loadu_ps(dst + b), _mm_loadu_ps(src + b)));
+#else
+    for (unsigned b = 0; b < n; ++b) dst[b] += src[b];
+#endif
+}
+
+void synthToPcm16(const float* in, int16_t* out, unsigned n) {
+#ifdef SYNTH_SSE2
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    for (unsigned b = 0; b < n; b += 8) { // packs 自带饱和截断
+        __m128i lo = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(in + b), scale));
+        __m128i hi = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(in + b + 4), scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + b), _mm_packs_epi32(lo, hi));
+    }
+#else
+    for (unsigned b = 0; b < n; ++b) {
+        float v = in[b] * 32767.0f;
+        v = v < -32768.0f ? -32768.0f : (v > 32767.0f ? 32767.0f : v);
+        out[b] = (int16_t)v;
+    }
+#endif
+}
+
+void synthRender(SfxId id, std::vector<int16_t>& out) {
+    const SynthEffect& fx = EFFECTS[id];
+    unsigned total = 0;
+    for (unsigned i = 0; i < fx.count; ++i) {
+        unsigned end = (unsigned)((fx.notes[i].start + fx.notes[i].dur) * SYNTH_SAMPLE_RATE);
+        if (end > total) total = end;
+    }
+    // 每个音符从块边界开始，缓冲区多留一块余量
+    std::vector<float> mix(roundUpBlock(total) + SYNTH_BLOCK, 0.0f), voice(mix.size());
+    for (unsigned i = 0; i < fx.count; ++i) {
+        const SynthNote& nt = fx.notes[i];
+        unsigned start = (unsigned)(nt.start * SYNTH_SAMPLE_RATE) / SYNTH_BLOCK * SYNTH_BLOCK;
+        unsigned len = roundUpBlock((unsigned)(nt.dur * SYNTH_SAMPLE_RATE));
+        if (start + len > mix.size()) len = (unsigned)mix.size() - start;
+        synthOscillator(&voice[0], len, nt.wave, nt.f0, nt.f1);
+        synthEnvelope(&voice[0], len, (unsigned)(nt.attack * SYNTH_SAMPLE_RATE), nt.gain);
+        synthMix(&mix[start], &voice[0], len);
+    }
+    std::vector<int16_t> pcm(mix.size());
+    synthToPcm16(&mix[0], &pcm[0], (unsigned)mix.size());
+    out.assign(pcm.begin(), pcm.begin() + total);
+}
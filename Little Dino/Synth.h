@@ -0,0 +1,37 @@
+#ifndef SYNTH_H
+#define SYNTH_H
+
+#include <stdint.h>
+#include <vector>
+
+// ==========================================
+// 程序化音效合成：直接生成 16 位单声道 PCM，不落盘
+// ==========================================
+const unsigned SYNTH_SAMPLE_RATE = 44100;
+
+enum SfxId {
+    SFX_SHUTDOWN,   // 碰撞音（原 shutdown.wav：440Hz 正弦 0.5 秒）
+    SFX_COIN,       // 吃金币
+    SFX_JUMP,       // 起跳
+    SFX_MILESTONE,  // 每 100 分
+    SFX_COUNT
+};
+
+const char* sfxName(SfxId id);
+
+// 渲染一个音效到 out（覆盖原内容）
+void synthRender(SfxId id, std::vector<int16_t>& out);
+
+// 以下为向量化内核（SSE2，不支持时退回标量），n 必须是 SYNTH_BLOCK 的倍数
+const unsigned SYNTH_BLOCK = 8;
+
+enum SynthWave { WAVE_SINE, WAVE_SQUARE, WAVE_TRIANGLE };
+
+// 线性扫频振荡器：频率在 n 个采样内从 f0 变到 f1，相位用闭式计算，没有逐样本递推
+void synthOscillator(float* out, unsigned n, SynthWave wave, float f0, float f1);
+// 线性起音 + 线性衰减包络，乘到 buf 上
+void synthEnvelope(float* buf, unsigned n, unsigned attack, float gain);
+void synthMix(float* dst, const float* src, unsigned n);
+void synthToPcm16(const float* in, int16_t* out, unsigned n);
+
+#endif
@@ -0,0 +1,213 @@
+#include "Track.h"
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include "GameWorld.h"
+
+Difficulty defaultDifficulty() {
+    Difficulty d;
+    d.speedMultiplier = SPEED_MULTIPLIER;
+    d.speedRamp = 0.8f;
+    d.maxSpeed = MAX_SPEED;
+    d.birdMinDistance = MIN_BIRD_SPAWN_DISTANCE;
+    d.cactusMin = 1.5f; d.cactusSpread = 1.5f;
+    return d;
+}
+
+float Difficulty::speedAt(float dist) const {
+    float s = 4.0f * speedMultiplier + (dist / 100.0f) * speedRamp; // 距离越远速度越快
+    return s > maxSpeed ? maxSpeed : s; // 限制最大速度
+}
+
+void TrackClock::advance(const Difficulty& df) {
+    dist += spd * SIM_DT;
+    spd = df.speedAt(dist);
+}
+
+// ==========================================
+// 生成器
+// ==========================================
+
+void TrackGenerator::start(uint32_t seed, const GameWorld& w) {
+    diff = w.difficulty;
+    rng.seed(seed);
+    tick = aheadTick = 0;
+    clock.start(diff, w.dist); ahead.start(diff, w.dist);
+    cactusTimer = coinTimer = birdTimer = 0;
+    cacti.clear(); coins.clear(); birds.clear();
+    // 读档时已在场的实体参与间距检查；此时累计滚动为 0，赛道坐标就是屏幕坐标
+    for (unsigned i = 0; i < w.cacti.size(); ++i) cacti.add(w.cacti.x[w.cacti.slot(i)], 0, 0, 0);
+    for (unsigned i = 0; i < w.coinList.size(); ++i) coins.add(w.coinList.x[w.coinList.slot(i)], 0, 0, 0);
+    for (unsigned i = 0; i < w.birds.size(); ++i) birds.add(w.birds.x[w.birds.slot(i)], 0, 0, 0);
+    nextCactus = cacti.handle(cacti.size());
+    for (uint32_t k = 0; k < CACTUS_LEAD_TICKS; ++k) advanceCacti();
+}
+
+// 间距检查用的列表满了：丢掉最早的、已经发出的实体，它在最左边，离新生成的位置最远
+static void makeRoom(EntityList& l, EntityHandle firstPending) {
+    if (l.full() && l.handle(0) != firstPending) l.popFront();
+}
+
+// 仙人掌：默认间隔 1.5~3.0s，与原来一样每步重新抽取阈值
+void TrackGenerator::advanceCacti() {
+    ahead.advance(diff);
+    cactusTimer += SIM_DT;
+    int spread = (int)(diff.cactusSpread * 10 + 0.5f);
+    if (cactusTimer > diff.cactusMin + (spread > 0 ? rng.nextInt(spread) : 0) / 10.0f) {
+        makeRoom(cacti, nextCactus);
+        assert(!cacti.full() && "pending cacti exceed capacity: cactusMin below CACTUS_MIN_FLOOR"); // valid() 已排除
+        EntityHandle h = cacti.add(WINDOW_WIDTH + 20 + ahead.scroll, 0, rng.nextInt(3), 0);
+        if (h != INVALID_ENTITY) cactusTick[cacti.find(h)] = aheadTick;
+        cactusTimer = 0;
+    }
+    ahead.scrolled();
+    ++aheadTick;
+}
+
+// 丢掉已滚出屏幕左侧的实体
+void TrackGenerator::prune(EntityList& l, float minX) {
+    while (!l.empty() && l.x[l.head] < minX) l.popFront();
+}
+
+unsigned TrackGenerator::next(TrackSpawn* out) {
+    unsigned n = 0;
+    advanceCacti(); // 保持领先 CACTUS_LEAD_TICKS 步
+    clock.advance(diff);
+
+    while (cacti.alive(nextCactus)) { // 发出本步出现的仙人掌
+        unsigned s = cacti.find(nextCactus);
+        if (cactusTick[s] != tick) break;
+        TrackSpawn& sp = out[n++];
+        sp.tick = tick; sp.kind = SPAWN_CACTUS; sp.type = cacti.type[s];
+        sp.x = WINDOW_WIDTH + 20; sp.y = 0;
+        ++nextCactus;
+    }
+
+    coinTimer += SIM_DT;
+    if (coinTimer > 3.0f + rng.nextInt(20) / 10.0f) { // 约 3~5 秒尝试刷一枚硬币
+        if (rng.nextInt(100) < 50) { // 50% 概率生成，避免过密
+            // 生成在屏外 100~200 像素：从随机点起每隔 25 像素找一个与仙人掌（包括稍后出现的）、飞鸟都隔开 100 的位置
+            int off = rng.nextInt(100);
+            for (int k = 0; k < 4; ++k) {
+                float cx = WINDOW_WIDTH + 100 + (float)((off + k * 25) % 100);
+                float tx = cx + clock.scroll;
+                if (cacti.anyWithin(tx, 100) || birds.anyWithin(tx, 100)) continue;
+                makeRoom(coins, INVALID_ENTITY);
+                coins.add(tx, 0, 0, 0);
+                TrackSpawn& sp = out[n++];
+                sp.tick = tick; sp.kind = SPAWN_COIN; sp.type = 0; sp.x = cx; sp.y = 90.0f;
+                break;
+            }
+        }
+        coinTimer = 0;
+    }
+
+    if (clock.dist > diff.birdMinDistance) { // 距离超过一定值后才刷飞鸟
+        birdTimer += SIM_DT;
+        if (birdTimer > 4.0f) { // 每 4 秒一只；位置不安全时顺延到第一个安全的步
+            float bx = WINDOW_WIDTH + 50;
+            float tx = bx + clock.scroll;
+            float gap = clock.spd * BIRD_CACTUS_GAP_TICKS;
+            if (gap < 80) gap = 80;
+            if (!coins.anyWithin(tx, 100) && !cacti.anyWithin(tx, gap)) { // 与硬币、仙人掌保持间隔
+                makeRoom(birds, INVALID_ENTITY);
+                birds.add(tx, 0, 0, 0);
+                TrackSpawn& sp = out[n++];
+                sp.tick = tick; sp.kind = SPAWN_BIRD; sp.type = 0; sp.x = bx; sp.y = BIRD_Y;
+                birdTimer = 0;
+            }
+        }
+    }
+
+    clock.scrolled();
+    float minX = clock.scroll - 200; // 屏幕 x < -200 的实体不会再影响间距
+    while (!cacti.empty() && cacti.handle(0) != nextCactus && cacti.x[cacti.head] < minX) cacti.popFront();
+    prune(coins, minX); prune(birds, minX);
+    ++tick;
+    return n;
+}
+
+static bool finiteClock(const TrackClock& c) {
+    return std::isfinite(c.dist) && std::isfinite(c.spd) && std::isfinite(c.scroll);
+}
+
+static bool finiteList(const EntityList& l) {
+    if (l.size() > ENTITY_CAPACITY) return false;
+    for (unsigned i = 0; i < l.size(); ++i) if (!std::isfinite(l.x[l.slot(i)])) return false;
+    return true;
+}
+
+bool TrackGenerator::valid() const {
+    if (!finiteList(cacti) || !finiteList(coins) || !finiteList(birds)) return false;
+    if (nextCactus - cacti.handle(0) > cacti.size()) return false; // 可以等于 size：全部已发出
+    if (rng.state == 0) return false; // xorshift 的不动点：之后永远输出 0
+    if (!finiteClock(clock) || !finiteClock(ahead)) return false;
+    if (!std::isfinite(cactusTimer) || !std::isfinite(coinTimer) || !std::isfinite(birdTimer)) return false;
+    // 难度参数与 tuner 的取值范围一致：有限、非负，速度为正，仙人掌最小间隔不低于 CACTUS_MIN_FLOOR
+    const float df[] = { diff.speedMultiplier, diff.speedRamp, diff.maxSpeed, diff.birdMinDistance, diff.cactusMin, diff.cactusSpread };
+    for (unsigned i = 0; i < sizeof(df) / sizeof(df[0]); ++i) if (!std::isfinite(df[i]) || df[i] < 0) return false;
+    if (!(diff.speedMultiplier > 0) || !(diff.maxSpeed > 0) || !(diff.cactusMin >= CACTUS_MIN_FLOOR)) return false;
+    return aheadTick >= tick;
+}
+
+// ==========================================
+// 预生成队列
+// ==========================================
+
+TrackFeed::TrackFeed() : head(0), tail(0), ready(0), consumed(0), quit(false) {}
+
+TrackFeed::~TrackFeed() {
+    stop();
+}
+
+void TrackFeed::start(const TrackGenerator& g, uint32_t from) {
+    stop();
+    gen = g;
+    if (from < g.tick) from = g.tick;
+    head.store(0); tail.store(0);
+    ready.store(from); consumed.store(from);
+    quit.store(false);
+    worker = std::thread(&TrackFeed::run, this);
+}
+
+void TrackFeed::stop() {
+    if (!worker.joinable()) return;
+    quit.store(true);
+    worker.join();
+}
+
+void TrackFeed::run() {
+    TrackSpawn buf[MAX_SPAWNS_PER_TICK];
+    uint32_t from = ready.load(std::memory_order_relaxed);
+    while (gen.tick < from && !quit.load(std::memory_order_relaxed)) gen.next(buf); // 快进：这些步已经模拟过
+    int idle = 0;
+    while (!quit.load(std::memory_order_acquire)) {
+        unsigned t = tail.load(std::memory_order_relaxed);
+        bool ahead = gen.tick > consumed.load(std::memory_order_relaxed) + LOOKAHEAD_TICKS;
+        bool full = FEED_CAPACITY - (t - head.load(std::memory_order_acquire)) < MAX_SPAWNS_PER_TICK;
+        if (ahead || full) { // 先让出几轮（无头模式消费很快），仍然领先就睡眠；游戏中每帧只消费一两步
+            if (++idle < 256) std::this_thread::yield();
+            else std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        idle = 0;
+
+        unsigned n = gen.next(buf);
+        for (unsigned k = 0; k < n; ++k) ring[(t + k) % FEED_CAPACITY] = buf[k];
+        tail.store(t + n, std::memory_order_release);
+        ready.store(gen.tick, std::memory_order_release);
+    }
+}
+
+unsigned TrackFeed::take(uint32_t tick, TrackSpawn* out) {
+    consumed.store(tick, std::memory_order_relaxed);
+    while (ready.load(std::memory_order_acquire) <= tick) std::this_thread::yield(); // 正常情况下生成线程领先数秒，不会等待
+
+    unsigned n = 0, h = head.load(std::memory_order_relaxed);
+    unsigned t = tail.load(std::memory_order_acquire);
+    for (; h != t && ring[h % FEED_CAPACITY].tick <= tick; ++h)
+        if (ring[h % FEED_CAPACITY].tick == tick) out[n++] = ring[h % FEED_CAPACITY];
+    head.store(h, std::memory_order_release);
+    return n;
+}
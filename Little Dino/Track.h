@@ -0,0 +1,139 @@
+#ifndef TRACK_H
+#define TRACK_H
+
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include "EntityStore.h"
+
+class GameWorld;
+
+// 每局独立的随机数流（xorshift32）：同一种子必然生成同样的障碍物序列
+struct WorldRng {
+    uint32_t state;
+
+    void seed(uint32_t s) {
+        s = (s ^ 0x9E3779B9u) * 0x85EBCA6Bu; // 打散相邻种子，并保证状态非 0
+        state = (s ^ (s >> 16)) | 1u;
+    }
+    uint32_t next() {
+        state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+        return state;
+    }
+    int nextInt(int n) { return (int)(next() % (uint32_t)n); } // [0, n)
+};
+
+// ==========================================
+// 难度参数：默认值即 GameWorld.h 中的常量；调参工具（tuner）按组替换后批量跑局
+// ==========================================
+struct Difficulty {
+    float speedMultiplier;          // 起始速度 = 4 * speedMultiplier
+    float speedRamp;                // 每行进 100 增加的速度
+    float maxSpeed;
+    float birdMinDistance;          // 行进超过该距离后才刷飞鸟
+    float cactusMin, cactusSpread;  // 仙人掌间隔 cactusMin + [0, cactusSpread) 秒，按 0.1 秒取值
+
+    // 行进距离对应的速度：距离越远速度越快，有上限
+    float speedAt(float dist) const;
+};
+
+Difficulty defaultDifficulty();
+
+// ==========================================
+// 赛道生成：障碍物、金币、飞鸟的出现时刻与位置只取决于种子，
+// 与玩家操作无关，因此可以提前若干秒算好，模拟每步按步号取用。
+// 生成器内部用“赛道坐标”（屏幕 x + 此前累计滚动量）记录在场和即将出现的实体，
+// 所有实体同速左移，赛道坐标之差就是屏幕上的间距
+// ==========================================
+enum TrackSpawnKind {
+    SPAWN_CACTUS,
+    SPAWN_COIN,
+    SPAWN_BIRD
+};
+
+struct TrackSpawn {
+    uint32_t tick;      // 在第几步出现（从开局/读档算起）
+    uint8_t kind;       // TrackSpawnKind
+    uint8_t type;       // 仙人掌类型
+    float x, y;         // 出现时的屏幕坐标；仙人掌的 y 由 GameWorld 按贴图高度决定
+};
+
+const unsigned MAX_SPAWNS_PER_TICK = 3;   // 每类每步最多一个
+const uint32_t CACTUS_LEAD_TICKS = 90;    // 仙人掌提前决定的步数，放金币/飞鸟时能看到稍后才出现的仙人掌
+// cactusMin 的下限：相邻仙人掌至少隔 2 步，提前决定、尚未发出的不超过 46 个，装得进 ENTITY_CAPACITY
+const float CACTUS_MIN_FLOOR = 0.02f;
+// 飞鸟与前后仙人掌至少相隔这么多步的滚动距离（按当前速度换算，不少于 80 像素）。
+// 跳过仙人掌、加速落地后还要来得及从鸟下穿过；间隔更小的组合无论怎么操作都会撞上
+const float BIRD_CACTUS_GAP_TICKS = 30.0f;
+
+// 推进方式与 GameWorld::step 完全一致：先加距离、再更新速度，生成之后再滚动
+struct TrackClock {
+    float dist, spd;
+    float scroll;       // 此前各步累计滚动的像素
+
+    void start(const Difficulty& df, float d) { dist = d; spd = df.speedAt(d); scroll = 0; }
+    void advance(const Difficulty& df);
+    void scrolled() { scroll += spd; }
+};
+
+class TrackGenerator {
+public:
+    // 按世界的难度参数，从其当前的距离与在场实体开始生成（新局时实体为空）
+    void start(uint32_t seed, const GameWorld& w);
+    // 生成第 tick 步出现的实体并前进一步，返回个数（不超过 MAX_SPAWNS_PER_TICK）
+    unsigned next(TrackSpawn* out);
+    // 从文件读入的状态是否自洽（实体数不超容量、待发仙人掌句柄有效、随机数状态非 0、浮点数有限），存档校验用
+    bool valid() const;
+
+    uint32_t tick;      // 下一次 next() 生成的步号
+
+private:
+    void advanceCacti();
+    void prune(EntityList& l, float minX);
+
+    Difficulty diff;
+    WorldRng rng;
+    TrackClock clock, ahead;    // ahead 比 clock 领先 CACTUS_LEAD_TICKS 步，只用来放仙人掌
+    uint32_t aheadTick;
+    float cactusTimer, coinTimer, birdTimer;
+    EntityList cacti, coins, birds;         // 赛道坐标；cacti 还包含已决定、尚未发出的
+    uint32_t cactusTick[ENTITY_CAPACITY];   // 按槽位：该仙人掌出现的步
+    EntityHandle nextCactus;                // 第一个尚未发出的仙人掌
+};
+
+// ==========================================
+// 预生成队列：工作线程让生成器保持领先模拟 LOOKAHEAD_TICKS 步，
+// 结果写入单生产者/单消费者无锁环形队列，模拟线程每步取出当步的实体。
+// 取用结果与直接调用 TrackGenerator::next 逐步生成完全相同
+// ==========================================
+const unsigned FEED_CAPACITY = 256;       // 2 的幂
+const uint32_t LOOKAHEAD_TICKS = 240;     // 约 4 秒
+
+class TrackFeed {
+public:
+    TrackFeed();
+    ~TrackFeed();
+
+    // 结束旧的生成线程，从 g 的当前状态起重新预生成；from 大于 g.tick 时先在工作线程上快进到该步（恢复快照用）
+    void start(const TrackGenerator& g, uint32_t from);
+    void stop();
+
+    // 取出第 tick 步的全部实体（tick 需逐步递增）；生成线程落后时在此等待
+    unsigned take(uint32_t tick, TrackSpawn* out);
+
+private:
+    void run();
+
+    TrackFeed(const TrackFeed&);
+    TrackFeed& operator=(const TrackFeed&);
+
+    TrackGenerator gen;                 // 只由工作线程访问
+    TrackSpawn ring[FEED_CAPACITY];
+    std::atomic<unsigned> head, tail;   // 消费者读到 / 生产者写到的位置（单调递增，取模定位）
+    std::atomic<uint32_t> ready;        // 小于该步号的实体已全部入队
+    std::atomic<uint32_t> consumed;     // 模拟当前所在的步，限制领先距离
+    std::atomic<bool> quit;
+    std::thread worker;
+};
+
+#endif
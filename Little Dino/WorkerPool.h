@@ -0,0 +1,67 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ==========================================
+// 简单线程池：提交任务、等待全部完成
+// ==========================================
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned threads = 0) : stopping(false), pending(0) {
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 2; // 无法探测核数时的保底值
+        for (unsigned i = 0; i < threads; ++i) workers.push_back(std::thread(&WorkerPool::run, this));
+    }
+
+    ~WorkerPool() {
+        { std::lock_guard<std::mutex> lock(m); stopping = true; }
+        wake.notify_all();
+        for (size_t i = 0; i < workers.size(); ++i) workers[i].join(); // 队列中剩余任务会先执行完
+    }
+
+    void submit(const std::function<void()>& job) {
+        { std::lock_guard<std::mutex> lock(m); jobs.push_back(job); ++pending; }
+        wake.notify_one();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(m);
+        idle.wait(lock, [this] { return pending == 0; });
+    }
+
+    unsigned size() const { return (unsigned)workers.size(); }
+
+private:
+    void run() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty()) return;
+                job = jobs.front(); jobs.pop_front();
+            }
+            job();
+            std::lock_guard<std::mutex> lock(m);
+            if (--pending == 0) idle.notify_all();
+        }
+    }
+
+    WorkerPool(const WorkerPool&);
+    WorkerPool& operator=(const WorkerPool&);
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()> > jobs;
+    std::mutex m;
+    std::condition_variable wake, idle;
+    bool stopping;
+    size_t pending;
+};
+
+#endif
@@ -0,0 +1,152 @@
+// ==========================================
+// 碰撞内核基准：逐个 getGlobalBounds + 内缩 + intersects（旧写法）
+// 对比打包后的标量内核与 SIMD 内核；再对比内缩矩形与“完整矩形 + 像素位图窄相”
+// 用法：bench_collide [Game.pak]（资源包需用 pack --raw 生成；没有时用椭圆位图代替贴图）
+// ==========================================
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "Bundle.h"
+#include "Collide.h"
+#include "Sprites.h"
+
+// sf::Transform::transformRect 的等价实现：4 个角点乘 3x3 矩阵后取包围盒
+struct LegacyBox {
+    float m[16]; // SFML 的 4x4 列主序矩阵
+    float w, h;
+    int margin;
+
+    WorldRect globalBounds() const {
+        float px[4] = { 0, w, 0, w }, py[4] = { 0, 0, h, h };
+        float l = 1e30f, t = 1e30f, r = -1e30f, b = -1e30f;
+        for (int k = 0; k < 4; ++k) {
+            float x = m[0] * px[k] + m[4] * py[k] + m[12];
+            float y = m[1] * px[k] + m[5] * py[k] + m[13];
+            l = x < l ? x : l; r = x > r ? x : r;
+            t = y < t ? y : t; b = y > b ? y : b;
+        }
+        return WorldRect(l, t, r - l, b - t);
+    }
+    bool checkCollision(const WorldRect& other) const {
+        WorldRect g = globalBounds();
+        WorldRect box(g.left + margin, g.top + margin, g.width - 2.0f * margin, g.height - 2.0f * margin);
+        return box.intersects(other);
+    }
+};
+
+// 与贴图同尺寸的实心椭圆，没有资源包时代替真实贴图
+void ellipseMask(PixelMask& m, int w, int h) {
+    std::vector<unsigned char> px((size_t)w * h * 4, 0);
+    for (int y = 0; y < h; ++y) for (int x = 0; x < w; ++x) {
+        float u = (x + 0.5f) / w * 2 - 1, v = (y + 0.5f) / h * 2 - 1;
+        if (u * u + v * v <= 1.0f) px[((size_t)y * w + x) * 4 + 3] = 255;
+    }
+    m.build(px.data(), w, h);
+}
+
+double nowMs() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char** argv) {
+    const unsigned sizes[3] = { 8, 32, 128 };
+    const long long work = 100000000; // 每种规模约测试的框数
+    const WorldRect dino(58, 206, 71, 78);
+    volatile unsigned long long sink = 0; // 只为让编译器保留被测循环，不作校验
+    static LegacyBox legacy[AABB_CAPACITY];
+    static AabbBatch batch;
+
+    std::cout << "kernel: " << aabbKernelName() << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  boxes   legacy ns/box  scalar ns/box    simd ns/box  speedup\n";
+    for (int s = 0; s < 3; ++s) {
+        unsigned n = sizes[s];
+        long long reps = work / n;
+        std::srand(1);
+        batch.clear();
+        for (unsigned i = 0; i < n; ++i) {
+            LegacyBox& lb = legacy[i];
+            for (int k = 0; k < 16; ++k) lb.m[k] = (k % 5 == 0) ? 1.0f : 0.0f; // 单位矩阵
+            lb.m[12] = (float)(std::rand() % 900) - 50; lb.m[13] = (float)(150 + std::rand() % 100);
+            lb.w = (float)(34 + std::rand() % 60); lb.h = (float)(58 + std::rand() % 40);
+            lb.margin = (i % 2) ? 6 : 5;
+            WorldRect g = lb.globalBounds();
+            batch.add(WorldRect(g.left + lb.margin, g.top + lb.margin, g.width - 2.0f * lb.margin, g.height - 2.0f * lb.margin));
+        }
+
+        // 三种写法结果必须一致
+        uint64_t m1[AABB_MASK_WORDS], m2[AABB_MASK_WORDS];
+        aabbOverlapMaskScalar(batch, dino, m1); aabbOverlapMask(batch, dino, m2);
+        for (unsigned i = 0; i < n; ++i) {
+            bool a = legacy[i].checkCollision(dino), b = CollisionHits::test(m1, i), c = CollisionHits::test(m2, i);
+            if (a != b || b != c) { std::cerr << "mismatch at box " << i << "\n"; return 1; }
+        }
+
+        double t0 = nowMs();
+        for (long long r = 0; r < reps; ++r) {
+            bool collision = false;
+            for (unsigned i = 0; i < n; ++i) if (legacy[i].checkCollision(dino)) collision = true;
+            sink += collision;
+        }
+        double legacyMs = nowMs() - t0;
+
+        uint64_t mask[AABB_MASK_WORDS];
+        t0 = nowMs();
+        for (long long r = 0; r < reps; ++r) { aabbOverlapMaskScalar(batch, dino, mask); sink += (unsigned)mask[0]; }
+        double scalarMs = nowMs() - t0;
+
+        t0 = nowMs();
+        for (long long r = 0; r < reps; ++r) { aabbOverlapMask(batch, dino, mask); sink += (unsigned)mask[0]; }
+        double simdMs = nowMs() - t0;
+
+        double per = 1e6 / ((double)reps * n);
+        std::cout << std::setw(7) << n << std::setw(15) << legacyMs * per << std::setw(15) << scalarMs * per
+                  << std::setw(15) << simdMs * per << std::setw(8) << std::setprecision(1) << legacyMs / simdMs << "x\n"
+                  << std::setprecision(3);
+    }
+
+    // 窄相：恐龙与仙人掌/飞鸟随机摆放在彼此附近，多数情况 AABB 会命中
+    SpriteMetrics sm = defaultSpriteMetrics();
+    static PixelMask masks[SPR_COUNT];
+    AssetBundle pak;
+    bool real = argc > 1 && pak.open(argv[1]);
+    for (int i = 0; i < SPR_COUNT && real; ++i) {
+        const BundleEntry* e = pak.find(SPRITE_FILES[i]);
+        real = e && e->kind == BUNDLE_RGBA;
+        if (real) { masks[i].build(pak.data(*e), (int)e->width, (int)e->height); sm.w[i] = (int)e->width; sm.h[i] = (int)e->height; }
+    }
+    if (!real) for (int i = 0; i < SPR_COUNT; ++i) ellipseMask(masks[i], sm.w[i], sm.h[i]);
+
+    const int hazardIds[5] = { SPR_CACTUS_L, SPR_CACTUS_S1, SPR_CACTUS_S2, SPR_BIRD_UP, SPR_BIRD_DOWN };
+    const int tests = 2000000;
+    std::vector<int> id(tests), hx(tests), hy(tests);
+    std::srand(2);
+    for (int k = 0; k < tests; ++k) { id[k] = hazardIds[std::rand() % 5]; hx[k] = std::rand() % 200 - 60; hy[k] = 120 + std::rand() % 140; }
+    const int dx = 50, dy = 198;
+
+    int rectHits = 0, pixelHits = 0;
+    double t0 = nowMs();
+    for (int k = 0; k < tests; ++k) {
+        int m = id[k] >= SPR_BIRD_UP ? 5 : 6;
+        WorldRect d(dx + 8.0f, dy + 8.0f, sm.w[SPR_DINO_RUN1] - 16.0f, sm.h[SPR_DINO_RUN1] - 16.0f);
+        WorldRect h(hx[k] + (float)m, hy[k] + (float)m, sm.w[id[k]] - 2.0f * m, sm.h[id[k]] - 2.0f * m);
+        rectHits += h.intersects(d);
+    }
+    double rectMs = nowMs() - t0;
+
+    t0 = nowMs();
+    for (int k = 0; k < tests; ++k) {
+        WorldRect d((float)dx, (float)dy, (float)sm.w[SPR_DINO_RUN1], (float)sm.h[SPR_DINO_RUN1]);
+        WorldRect h((float)hx[k], (float)hy[k], (float)sm.w[id[k]], (float)sm.h[id[k]]);
+        if (h.intersects(d) && pixelOverlap(masks[SPR_DINO_RUN1], dx, dy, masks[id[k]], hx[k], hy[k])) ++pixelHits;
+    }
+    double pixelMs = nowMs() - t0;
+    sink += rectHits + pixelHits;
+
+    std::cout << "\nnarrow phase (" << (real ? "sprite" : "ellipse") << " masks), " << tests << " placements\n";
+    std::cout << "  inset rect    " << std::setw(8) << rectMs * 1e6 / tests << " ns/test  " << rectHits << " hits\n";
+    std::cout << "  rect + pixel  " << std::setw(8) << pixelMs * 1e6 / tests << " ns/test  " << pixelHits << " hits\n";
+    return 0;
+}
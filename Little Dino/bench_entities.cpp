@@ -0,0 +1,164 @@
+// ==========================================
+// 实体布局基准：旧的 std::vector<Cactus>（每个对象带完整 sf::Sprite）
+// 对比 EntityRing 结构数组，分别测移动与碰撞的耗时；
+// 再对比生成间距检查/碰撞候选的线性扫描与按 x 二分；最后测整个世界快照的保存与恢复
+// 用法：bench_entities
+// ==========================================
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "EntityStore.h"
+#include "GameWorld.h"
+
+// 与 sf::Sprite 相同的内存布局（SFML 2.5：Drawable 虚表 + Transformable + 4 顶点 + 纹理指针 + 子矩形），
+// 不链接 SFML 也能重现旧布局的缓存占用
+struct LegacyVertex { float px, py; unsigned char rgba[4]; float u, v; };
+struct LegacySprite {
+    virtual ~LegacySprite() {}
+    float originX, originY, posX, posY, rotation, scaleX, scaleY;
+    float transform[16]; mutable bool transformNeedUpdate;
+    float inverse[16]; mutable bool inverseNeedUpdate;
+    LegacyVertex vertices[4];
+    const void* texture;
+    int rect[4];
+
+    void setPosition(float x, float y) { posX = x; posY = y; transformNeedUpdate = inverseNeedUpdate = true; }
+};
+
+// 旧 Cactus：精灵 + 重复的位置 + 类型
+struct LegacyCactus {
+    LegacySprite sprite;
+    float posX, posY, prevX;
+    int type;
+
+    void update(float spd) { prevX = posX; posX -= spd; sprite.setPosition(posX, posY); }
+    WorldRect bounds() const { // getGlobalBounds() 在未旋转缩放时即位置 + 子矩形尺寸
+        return WorldRect(sprite.posX + 6, sprite.posY + 6, sprite.rect[2] - 12.0f, sprite.rect[3] - 12.0f);
+    }
+};
+
+static EntityRing<131072> soa; // 容量需覆盖最大规模；体积较大，放在静态区
+
+double nowMs() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main() {
+    const SpriteMetrics m = defaultSpriteMetrics();
+    const WorldRect dino(DINO_X + 8, 206, m.w[SPR_DINO_RUN1] - 16.0f, m.h[SPR_DINO_RUN1] - 16.0f);
+    const int sizes[3] = { 10, 1000, 100000 };
+    const long long work = 50000000; // 每种规模约处理的实体·步数
+    volatile unsigned long long sink = 0; // 只为让编译器保留被测循环，不作校验
+
+    std::cout << "sizeof(LegacyCactus) = " << sizeof(LegacyCactus) << " bytes, SoA hot data = "
+              << sizeof(float) * 2 + 2 << " bytes per entity\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "   entities  layout   update ns/ent  collide ns/ent\n";
+
+    for (int s = 0; s < 3; ++s) {
+        int n = sizes[s];
+        int steps = (int)(work / n);
+        std::srand(1);
+
+        std::vector<LegacyCactus> aos(n);
+        soa.clear(); // 从槽位 0 开始连续存放
+        for (int i = 0; i < n; ++i) {
+            int t = std::rand() % 3;
+            float x = (float)(std::rand() % 4000), y = 280.0f - m.h[SPR_CACTUS_L + t] + 15.0f;
+            LegacyCactus& c = aos[i];
+            c.posX = c.prevX = x; c.posY = y; c.type = t;
+            c.sprite.rect[0] = c.sprite.rect[1] = 0; c.sprite.rect[2] = m.w[SPR_CACTUS_L + t]; c.sprite.rect[3] = m.h[SPR_CACTUS_L + t];
+            c.sprite.setPosition(x, y);
+            soa.add(x, y, t, 0);
+        }
+        float cw[3], ch[3];
+        for (int t = 0; t < 3; ++t) { cw[t] = m.w[SPR_CACTUS_L + t] - 12.0f; ch[t] = m.h[SPR_CACTUS_L + t] - 12.0f; }
+
+        // 每步速度正负交替，位置不会漂走
+        double t0 = nowMs();
+        for (int k = 0; k < steps; ++k) { float spd = (k & 1) ? -1.0f : 1.0f; for (int i = 0; i < n; ++i) aos[i].update(spd); }
+        double aosUpd = nowMs() - t0;
+
+        t0 = nowMs();
+        for (int k = 0; k < steps; ++k) { int hit = 0; for (int i = 0; i < n; ++i) hit += aos[i].bounds().intersects(dino); sink += hit; }
+        double aosCol = nowMs() - t0;
+
+        t0 = nowMs();
+        for (int k = 0; k < steps; ++k) soa.scroll((k & 1) ? -1.0f : 1.0f);
+        double soaUpd = nowMs() - t0;
+
+        t0 = nowMs();
+        for (int k = 0; k < steps; ++k) {
+            int hit = 0;
+            const float* x = soa.x; const float* y = soa.y; const unsigned char* ty = soa.type;
+            for (int i = 0; i < n; ++i) hit += WorldRect(x[i] + 6, y[i] + 6, cw[ty[i]], ch[ty[i]]).intersects(dino);
+            sink += hit;
+        }
+        double soaCol = nowMs() - t0;
+
+        double per = 1e6 / ((double)steps * n);
+        std::cout << std::setw(11) << n << "  vector  " << std::setw(14) << aosUpd * per << std::setw(16) << aosCol * per << "\n";
+        std::cout << std::setw(11) << n << "  SoA     " << std::setw(14) << soaUpd * per << std::setw(16) << soaCol * per << "\n";
+    }
+
+    // 实体按生成顺序 x 递增；查询点随机，统计每次查询的耗时
+    std::cout << "\n   entities  query    linear ns/query  indexed ns/query\n";
+    const int queries = 200000;
+    for (int s = 0; s < 3; ++s) {
+        int n = sizes[s];
+        soa.clear();
+        for (int i = 0; i < n; ++i) soa.add(i * 150.0f, 200.0f, i % 3, 0);
+        int nq = n >= 100000 ? queries / 100 : queries; // 线性扫描在大规模下太慢，少查几次
+        std::vector<float> q(nq);
+        for (int k = 0; k < nq; ++k) q[k] = (float)(std::rand() % (n * 150 + 1000));
+        int reps = n <= 10 ? 20 : 1;
+
+        double t0 = nowMs();
+        for (int r = 0; r < reps; ++r) for (int k = 0; k < nq; ++k) {
+            bool hit = false;
+            for (unsigned i = 0; i < soa.size(); ++i) if (std::abs(soa.x[soa.slot(i)] - q[k]) < 100) hit = true;
+            sink += hit;
+        }
+        double linNear = nowMs() - t0;
+        t0 = nowMs();
+        for (int r = 0; r < reps; ++r) for (int k = 0; k < nq; ++k) sink += soa.anyWithin(q[k], 100);
+        double idxNear = nowMs() - t0;
+
+        // 碰撞候选：x 落在恐龙前后一个身位内的实体
+        t0 = nowMs();
+        for (int r = 0; r < reps; ++r) for (int k = 0; k < nq; ++k) {
+            int c = 0;
+            for (unsigned i = 0; i < soa.size(); ++i) { float x = soa.x[soa.slot(i)]; c += (x > q[k] - 80 && x < q[k] + 80); }
+            sink += c;
+        }
+        double linWin = nowMs() - t0;
+        t0 = nowMs();
+        for (int r = 0; r < reps; ++r) for (int k = 0; k < nq; ++k) 
+            sink += soa.lowerBound(q[k] + 80) - soa.lowerBound(q[k] - 80);
+        double idxWin = nowMs() - t0;
+
+        double per = 1e6 / ((double)reps * nq);
+        std::cout << std::setw(11) << n << "  spawn  " << std::setw(17) << linNear * per << std::setw(18) << idxNear * per << "\n";
+        std::cout << std::setw(11) << n << "  window " << std::setw(17) << linWin * per << std::setw(18) << idxWin * per << "\n";
+    }
+
+    // 世界快照：跑到局中（场上有障碍物）后反复 save / restore
+    GameWorld world(m);
+    world.reset(3);
+    WorldInput none;
+    for (int t = 0; t < 600; ++t) if (world.step(none) & EV_DIED) world.reset(4);
+    static WorldState snap;
+    const int snaps = 1000000;
+    double t0 = nowMs();
+    for (int k = 0; k < snaps; ++k) { world.save(snap); sink += snap.tick; }
+    double saveMs = nowMs() - t0;
+    t0 = nowMs();
+    for (int k = 0; k < snaps; ++k) { world.restore(snap); sink += world.tick; }
+    double restoreMs = nowMs() - t0;
+    std::cout << "\nsnapshot   sizeof(WorldState) = " << sizeof(WorldState) << " bytes\n";
+    std::cout << "           save " << saveMs * 1e6 / snaps << " ns, restore " << restoreMs * 1e6 / snaps << " ns\n";
+    return 0;
+}
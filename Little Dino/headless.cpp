@@ -0,0 +1,137 @@
+// ==========================================
+// 无头模式：不开窗口、不加载资源，尽可能快地跑模拟
+// 用法：headless [--ticks N] [--seed S] [--policy none|random|react|search] [--pak Game.pak] [--rect] [--feed]
+//              [--record out.replay] [--replay in.replay [--loops K]]
+// 资源包里有预解码像素（pack --raw）时按像素判定碰撞，否则退回内缩矩形。
+// 第 k 局的种子为 S + k；--record 录下第一局，--replay 按录像重新模拟（K 次，用于同负载测速）
+// --feed 与窗口版一样在工作线程上预生成赛道，结果应与默认的就地生成完全相同
+// search 策略用于长时间挂机测试：每次死亡都打印种子与位置，可用 --record 之外的方式单独复现
+// ==========================================
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "GameWorld.h"
+#include "Replay.h"
+#include "SimTools.h"
+
+const char* USAGE = "Usage: headless [--ticks N] [--seed S] [--policy none|random|react|search] [--pak Game.pak] [--rect] [--feed]\n"
+                    "                [--record out.replay] [--replay in.replay [--loops K]]\n";
+
+// 按录像重新模拟；返回进程退出码
+int playReplay(const std::string& path, int loops, bool pixel, const SpriteMetrics& metrics, const PixelMask* masks, TrackFeed* feed) {
+    ReplayPlayer player;
+    if (!player.load(path)) { std::cerr << "Cannot read replay: " << path << "\n"; return 1; }
+    bool wantPixel = (player.flags() & REPLAY_PIXEL_COLLISION) != 0;
+    if (wantPixel && !pixel) { std::cerr << "Replay was recorded with pixel collision; Game.pak with raw sprites is required\n"; return 1; }
+
+    GameWorld world(metrics);
+    if (wantPixel) world.setMasks(masks);
+    world.setFeed(feed);
+    long long total = 0;
+    unsigned events = 0;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < loops; ++k) {
+        player.rewind();
+        world.reset(player.seed());
+        events = 0;
+        while (!player.finished() && !(events & EV_DIED)) events = world.step(replayInput(player.next()));
+        total += player.position();
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "replay     " << path << " (seed " << player.seed() << ", " << player.ticks() << " ticks, "
+              << (wantPixel ? "pixel" : "rect") << " collision)\n";
+    std::cout << "result     " << ((events & EV_DIED) ? "died" : "ended") << " at tick " << player.position()
+              << ", score " << world.score() << ", coins " << world.coins << "\n";
+    std::cout << "rate       " << (sec > 0 ? total / sec : 0.0) << " ticks/s over " << loops << " loops\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    long long ticks = 1000000;
+    unsigned seed = 1;
+    Policy policy = POLICY_REACT;
+    std::string pakPath = "Game.pak";
+    bool rectOnly = false;
+    bool useFeed = false;
+    std::string recordPath, replayPath;
+    int loops = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--ticks" && i + 1 < argc) ticks = std::atoll(argv[++i]);
+        else if (a == "--seed" && i + 1 < argc) seed = (unsigned)std::strtoul(argv[++i], 0, 10);
+        else if (a == "--policy" && i + 1 < argc) {
+            std::string p = argv[++i];
+            if (!parsePolicy(p, policy)) { std::cerr << "Unknown policy: " << p << "\n"; return 1; }
+        }
+        else if (a == "--pak" && i + 1 < argc) pakPath = argv[++i];
+        else if (a == "--rect") rectOnly = true;
+        else if (a == "--feed") useFeed = true;
+        else if (a == "--record" && i + 1 < argc) recordPath = argv[++i];
+        else if (a == "--replay" && i + 1 < argc) replayPath = argv[++i];
+        else if (a == "--loops" && i + 1 < argc) loops = std::atoi(argv[++i]);
+        else { std::cerr << USAGE; return 1; }
+    }
+
+    ScriptedPlayer player(policy); // 玩家有自己的随机数流，与世界的互不影响
+    player.reset(seed);
+    SpriteMetrics metrics = defaultSpriteMetrics();
+    static PixelMask masks[SPR_COUNT];
+    bool pixel = !rectOnly && loadMasks(pakPath, metrics, masks);
+    TrackFeed feed;
+    if (!replayPath.empty()) return playReplay(replayPath, loops > 0 ? loops : 1, pixel, metrics, masks, useFeed ? &feed : 0);
+
+    GameWorld world(metrics);
+    if (pixel) world.setMasks(masks);
+    if (useFeed) world.setFeed(&feed);
+    world.reset(seed);
+    std::cout << "collision  " << (pixel ? "pixel masks from " + pakPath : std::string("inset rects")) << "\n";
+    std::cout << "track      " << (useFeed ? "look-ahead worker thread" : "generated inline") << "\n";
+    std::cout << "policy     " << policyName(policy) << "\n";
+
+    ReplayRecorder recorder;
+    bool recording = !recordPath.empty();
+    int recordedScore = 0;
+    if (recording) recorder.begin(seed, pixel ? REPLAY_PIXEL_COLLISION : 0);
+
+    int runs = 0, bestScore = 0;
+    long long totalScore = 0, totalCoins = 0;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (long long t = 0; t < ticks; ++t) {
+        WorldInput in = player.input(world);
+        if (recording) recorder.record(replayBits(in, false));
+
+        if (world.step(in) & EV_DIED) { // 死亡后立即开下一局
+            ++runs;
+            totalScore += world.score(); totalCoins += world.coins;
+            if (world.score() > bestScore) bestScore = world.score();
+            if (recording) { recording = false; recordedScore = world.score(); recorder.save(recordPath); }
+            if (policy == POLICY_SEARCH) // 机器人也躲不开的局面：记下来单独检查生成器
+                std::cout << "death      seed " << world.seed << ", tick " << world.tick << ", dist " << world.dist
+                          << ", score " << world.score() << ", hit " << SPRITE_FILES[world.killer] << "\n";
+            world.reset(seed + runs);
+            player.reset(seed + runs);
+        }
+    }
+    if (recording) { recordedScore = world.score(); recorder.save(recordPath); } // 第一局在步数用完时还没结束
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    double simSec = ticks * SIM_DT;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "ticks      " << ticks << " (" << simSec << " s game time)\n";
+    std::cout << "wall       " << sec * 1000.0 << " ms\n";
+    std::cout << "rate       " << (sec > 0 ? ticks / sec : 0.0) << " ticks/s, " << (sec > 0 ? simSec / sec : 0.0) << "x real time\n";
+    std::cout << "runs       " << runs << " finished";
+    if (runs > 0) std::cout << ", avg score " << (double)totalScore / runs << ", best " << bestScore << ", avg coins " << (double)totalCoins / runs;
+    std::cout << "\n";
+    std::cout << "current    score " << world.score() << ", coins " << world.coins << "\n";
+    std::cout << "overflow   " << world.spawnDrops << " spawns dropped (entity capacity " << ENTITY_CAPACITY << ")\n";
+    if (policy == POLICY_SEARCH) std::cout << "search     " << (double)player.bot.simulatedTicks / ticks << " simulated ticks per tick\n";
+    if (!recordPath.empty()) std::cout << "recorded   " << recordPath << " (" << recorder.tickCount() << " ticks, score " << recordedScore << ")\n";
+    return 0;
+}
@@ -9,19 +9,26 @@
 #include <cstdlib>           
 #include <ctime>             
 #include <cmath>             
+#include <memory>            
+#include <atomic>            
+#include <chrono>            
+#include <iterator>          
+#include "WorkerPool.h"
+#include "Bundle.h"
+#include "Synth.h"
+#include "GameWorld.h"
+#include "Replay.h"
+#include "Bot.h"
+#include "ObsFrame.h"
+#include "Rewind.h"
+#include "Persist.h"
+#include "SaveFile.h"
 
 // ==========================================
-// 全局常量定义
+// 全局常量定义（模拟规则见 GameWorld.h）
 // ==========================================
-const int WINDOW_WIDTH = 800;           
-const int WINDOW_HEIGHT = 400;          
-const float GRAVITY = 0.8f;             
-const float JUMP_FORCE = -17.8f;        
-const float GROUND_Y = 250.0f;          
-const float SCORE_MULTIPLIER = 0.3f;    
-const float SPEED_MULTIPLIER = 1.4f;    
-const float MAX_SPEED = 16.0f;          
-const float MIN_BIRD_SPAWN_DISTANCE = 300.0f; 
+const float MAX_FRAME_TIME = 0.25f;     // 单帧最多追赶的时间，避免卡顿后连续补帧
+const float REWIND_SCRUB_SPEED = 2.0f;  // 按住 ←/→ 时历史前后移动的倍速
 
 // ==========================================
 // UI 配色方案
@@ -45,7 +52,11 @@ enum GameState {
     INTRO,      
     ABOUT,      
     GAME_OVER,  
-    COUNTDOWN   
+    COUNTDOWN,  
+    REWIND,     // 死亡后倒回历史，选择从哪一步继续
+    SLOTS,      // 存档位列表：读档或存档时选择存档位
+    LEADERBOARD,// 本机排行榜（RunLog.h）
+    RECOVER     // 启动时发现上次没结束的局（Journal.h），选择继续或放弃
 };
 
 // ==========================================
@@ -64,6 +75,8 @@ std::string formatScore(int value) {
     return oss.str();       
 }
 
+float lerp(float a, float b, float t) { return a + (b - a) * t; }
+
 bool isJumpKey(sf::Keyboard::Key key) {
     return (key == sf::Keyboard::Space || key == sf::Keyboard::Up || key == sf::Keyboard::W);
 }
@@ -76,27 +89,11 @@ void drawCenteredText(sf::RenderWindow& window, sf::Text& text, float x, float y
     window.draw(text);      
 }
 
-// ==========================================
-// 数据读写函数
-// ==========================================
-
-void loadHighData(int& hs, int& hc) {
-    std::ifstream in("highscore.dat"); 
-    if (in.is_open()) { 
-        in >> hs >> hc; 
-        in.close();     
-    } else {            
-        hs = 0;         
-        hc = 0;         
-    }
-}
-
-void saveHighData(int hs, int hc) {
-    std::ofstream out("highscore.dat"); 
-    if (out.is_open()) { 
-        out << hs << " " << hc; 
-        out.close();     
-    }
+// 排行榜上的死因
+std::string causeName(int killer) {
+    if (killer == SPR_CACTUS_L || killer == SPR_CACTUS_S1 || killer == SPR_CACTUS_S2) return "Cactus";
+    if (killer == SPR_BIRD_UP || killer == SPR_BIRD_DOWN) return "Bird";
+    return "-"; // 迁移来的旧最高分没有死因
 }
 
 // ==========================================
@@ -160,178 +157,258 @@ void drawHudItem(sf::RenderWindow& window, float x, float y, const std::string&
     window.draw(tV);
 }
 
+// 加载界面：字体尚未就绪，只画卡片和进度条
+void drawLoadingBar(sf::RenderWindow& window, float progress) {
+    drawCard(window, WINDOW_WIDTH/2 - 160, WINDOW_HEIGHT/2 - 30, 320, 60);
+    sf::RectangleShape track(sf::Vector2f(280, 14)); 
+    track.setPosition(WINDOW_WIDTH/2 - 140, WINDOW_HEIGHT/2 - 7);
+    track.setFillColor(sf::Color(230, 230, 240));
+    window.draw(track);
+    sf::RectangleShape bar(sf::Vector2f(280 * progress, 14)); 
+    bar.setPosition(WINDOW_WIDTH/2 - 140, WINDOW_HEIGHT/2 - 7);
+    bar.setFillColor(UI_PRIMARY);
+    window.draw(bar);
+}
+
 // ==========================================
-// 游戏实体类定义
+// 纹理图集与批量渲染
 // ==========================================
 
-class Dino {
-public:
-    sf::Sprite sprite;      
-    sf::Vector2f velocity;  
-    bool onGround;          
-    sf::Clock animationClock; 
-    sf::Texture run1Tex, run2Tex, jumpTex; 
-    bool showRun1;          
-    float startY;           
-
-    Dino(const sf::Texture& r1, const sf::Texture& r2, const sf::Texture& j) : run1Tex(r1), run2Tex(r2), jumpTex(j), onGround(true), showRun1(true) {
-        sprite.setTexture(run1Tex); 
-        startY = (GROUND_Y + 30.0f) - static_cast<float>(run1Tex.getSize().y) + 12.0f;
-        sprite.setPosition(50, startY); 
-        velocity.y = 0; 
-    }
-
-    void jump() { 
-        if (onGround) { 
-            velocity.y = JUMP_FORCE; 
-            onGround = false; 
-            sprite.setTexture(jumpTex); 
-        } 
-    }
+// 一张待打包图片的 RGBA8 像素（来自 sf::Image 或资源包里的预解码数据）
+struct SpriteSource {
+    const sf::Uint8* pixels;
+    unsigned width, height;
 
-    void fallFaster() { 
-        if (!onGround) { 
-            if (velocity.y < 0) velocity.y = 0; 
-            velocity.y += 5.0f; 
-        } 
-    }
+    SpriteSource() : pixels(0), width(0), height(0) {}
+    SpriteSource(const sf::Uint8* p, unsigned w, unsigned h) : pixels(p), width(w), height(h) {}
+};
 
-    void update(float dt) {
-        if (!onGround) { 
-            velocity.y += GRAVITY; 
-            sprite.move(0, velocity.y); 
-            if (sprite.getPosition().y >= startY) { 
-                sprite.setPosition(50, startY); 
-                velocity.y = 0; 
-                onGround = true; 
-                showRun1 = true; 
-                sprite.setTexture(run1Tex); 
+// 启动时把所有 PNG 打包进一张纹理，绘制时不再切换纹理
+class TextureAtlas {
+public:
+    sf::Texture texture;
+    std::vector<sf::IntRect> slices[SPR_COUNT]; // 超过图集宽度的图片（如 Track.png）按列切片
+    sf::Vector2i size[SPR_COUNT];
+
+    bool build(const SpriteSource* images) {
+        const unsigned pad = 1; // 间隔 1 像素，防止相邻图片串色
+        unsigned maxW = sf::Texture::getMaximumSize();
+        unsigned atlasW = maxW < 2048 ? maxW : 2048;
+
+        // 先切片，再按高度从高到低做行（shelf）排布
+        std::vector<int> order; std::vector<sf::IntRect> src;
+        for (int i = 0; i < SPR_COUNT; ++i) {
+            sf::Vector2u s(images[i].width, images[i].height);
+            size[i] = sf::Vector2i(s.x, s.y);
+            slices[i].clear();
+            for (unsigned x = 0; x < s.x; x += atlasW) {
+                unsigned w = (s.x - x < atlasW) ? s.x - x : atlasW;
+                order.push_back(i); src.push_back(sf::IntRect(x, 0, w, s.y));
             }
         }
-        if (onGround && animationClock.getElapsedTime().asMilliseconds() > 150) { 
-            showRun1 = !showRun1; 
-            sprite.setTexture(showRun1 ? run1Tex : run2Tex); 
-            animationClock.restart(); 
+        std::vector<size_t> idx(src.size());
+        for (size_t i = 0; i < idx.size(); ++i) idx[i] = i;
+        for (size_t i = 1; i < idx.size(); ++i) // 插入排序，数量很少
+            for (size_t j = i; j > 0 && src[idx[j]].height > src[idx[j-1]].height; --j) std::swap(idx[j], idx[j-1]);
+
+        std::vector<sf::IntRect> dst(src.size());
+        unsigned penX = 0, penY = 0, shelfH = 0;
+        for (size_t k = 0; k < idx.size(); ++k) {
+            const sf::IntRect& r = src[idx[k]];
+            if (penX + r.width > atlasW) { penX = 0; penY += shelfH + pad; shelfH = 0; }
+            dst[idx[k]] = sf::IntRect(penX, penY, r.width, r.height);
+            penX += r.width + pad;
+            if ((unsigned)r.height > shelfH) shelfH = r.height;
+        }
+        unsigned atlasH = penY + shelfH;
+        if (atlasH > maxW) return false;
+
+        if (!texture.create(atlasW, atlasH)) return false;
+        std::vector<sf::Uint8> blank((size_t)atlasW * atlasH * 4, 0); // 间隔区清成透明
+        texture.update(blank.data());
+        // 像素直接从源数据上传，不经过中间 sf::Image
+        for (size_t k = 0; k < src.size(); ++k) {
+            const SpriteSource& img = images[order[k]];
+            if (src[k].width == (int)img.width) texture.update(img.pixels, img.width, img.height, dst[k].left, dst[k].top);
+            else for (int y = 0; y < src[k].height; ++y) // 切片不连续，逐行上传
+                texture.update(img.pixels + ((size_t)y * img.width + src[k].left) * 4, src[k].width, 1, dst[k].left, dst[k].top + y);
+            slices[order[k]].push_back(dst[k]);
         }
+        return true;
     }
+};
 
-    sf::FloatRect getBounds() const { 
-        sf::FloatRect b = sprite.getGlobalBounds(); 
-        return sf::FloatRect(b.left+8, b.top+8, b.width-16, b.height-16); 
-    }
+// 资源缓存：图集只在这里上传一次，绘制时按 SpriteId 取子区域
+class ResourceCache {
+public:
+    bool loadSprites(const SpriteSource* images) { return atlas.build(images); }
+
+    const TextureAtlas& getAtlas() const { return atlas; }
 
-    void draw(sf::RenderWindow& w) { w.draw(sprite); }
+private:
+    TextureAtlas atlas;
 };
 
-class Cactus {
+// 每帧把整个场景拼成一个四边形顶点数组，一次 draw 提交
+class SpriteBatch {
 public:
-    sf::Sprite sprite;    
-    sf::Vector2f position;
-    int type;             
-
-    bool init(float x, int t, const sf::Texture& tex) {
-        type = t; 
-        sprite.setTexture(tex); 
-        position.x = x;
-        position.y = (GROUND_Y + 30.0f) - static_cast<float>(tex.getSize().y) + 15.0f;
-        sprite.setPosition(position); 
-        return true;
+    const TextureAtlas* atlas;
+    sf::VertexArray verts;
+
+    SpriteBatch(const TextureAtlas& a) : atlas(&a), verts(sf::Quads) {}
+
+    void clear() { verts.clear(); }
+
+    void add(SpriteId id, sf::Vector2f pos) {
+        const std::vector<sf::IntRect>& sl = atlas->slices[id];
+        float x = pos.x;
+        for (size_t i = 0; i < sl.size(); ++i) {
+            const sf::IntRect& r = sl[i];
+            float w = (float)r.width, h = (float)r.height;
+            // 视野外的不提交（包括生成在屏幕右侧外的障碍物）
+            if (x + w > 0 && x < WINDOW_WIDTH && pos.y + h > 0 && pos.y < WINDOW_HEIGHT) {
+                float u = (float)r.left, v = (float)r.top;
+                verts.append(sf::Vertex(sf::Vector2f(x, pos.y), sf::Vector2f(u, v)));
+                verts.append(sf::Vertex(sf::Vector2f(x + w, pos.y), sf::Vector2f(u + w, v)));
+                verts.append(sf::Vertex(sf::Vector2f(x + w, pos.y + h), sf::Vector2f(u + w, v + h)));
+                verts.append(sf::Vertex(sf::Vector2f(x, pos.y + h), sf::Vector2f(u, v + h)));
+            }
+            x += w;
+        }
     }
 
-    void update(float s) { 
-        position.x -= s; 
-        sprite.setPosition(position); 
+    void draw(sf::RenderWindow& w) {
+        if (verts.getVertexCount() == 0) return;
+        sf::RenderStates states(&atlas->texture);
+        w.draw(verts, states);
     }
+};
 
-    bool checkCollision(const sf::FloatRect& o) const { 
-        sf::FloatRect b = sprite.getGlobalBounds(); 
-        return sf::FloatRect(b.left+6, b.top+6, b.width-12, b.height-12).intersects(o); 
-    }
+// ==========================================
+// 资源加载和全局变量
+// ==========================================
+ResourceCache resources;
+AssetBundle bundle; // Game.pak 存在时所有资源都从映射内存创建
+sf::Font font; 
+std::vector<char> fontData; // 无资源包时读入的字体文件；loadFromMemory 要求数据在字体生命周期内有效
+sf::SoundBuffer sfxBuf[SFX_COUNT]; // 全部音效在内存中合成
+PixelMask spriteMasks[SPR_COUNT]; // 像素级碰撞位图，解码后在工作线程里生成
+sf::Sound shutSound, coinSound, jumpSound, milestoneSound; 
+sf::Music bgm;
 
-    void draw(sf::RenderWindow& w) { w.draw(sprite); }
-};
+double elapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
 
-class Coin {
+// 工作线程只做文件读取和解码（不碰 OpenGL/OpenAL），GPU 上传留给渲染线程
+class AssetLoader {
 public:
-    sf::Sprite sprite;    
-    sf::Vector2f position;
-    bool collected;       
-
-    bool init(float x, float y, const sf::Texture& tex) { 
-        sprite.setTexture(tex); 
-        position = sf::Vector2f(x, y); 
-        sprite.setPosition(position); 
-        collected = false; 
-        return true; 
+    enum { JOB_FONT = SPR_COUNT, JOB_SFX, JOB_COUNT };
+
+    sf::Image images[SPR_COUNT];
+    SpriteSource sources[SPR_COUNT];
+    const void* fontPtr; size_t fontSize;
+    std::vector<int16_t> sfxSamples[SFX_COUNT];
+    double sfxMs[SFX_COUNT];
+    bool ok[JOB_COUNT];
+    double decodeMs[JOB_COUNT];
+
+    AssetLoader() : fontPtr(0), fontSize(0), done(0) {
+        for (int i = 0; i < JOB_COUNT; ++i) { ok[i] = false; decodeMs[i] = 0; }
     }
 
-    void update(float s) { 
-        position.x -= s; 
-        sprite.setPosition(position); 
+    void start() {
+        startTime = std::chrono::steady_clock::now();
+        unsigned n = std::thread::hardware_concurrency();
+        pool.reset(new WorkerPool(n == 0 || n > JOB_COUNT ? JOB_COUNT : n));
+        for (int i = 0; i < JOB_COUNT; ++i) pool->submit([this, i] { runJob(i); });
     }
 
-    bool checkCollision(const sf::FloatRect& o) const { 
-        if(collected) return false; 
-        sf::FloatRect b = sprite.getGlobalBounds(); 
-        return sf::FloatRect(b.left-5, b.top-5, b.width+10, b.height+10).intersects(o); 
-    }
-
-    void draw(sf::RenderWindow& w) { if(!collected) w.draw(sprite); }
-};
+    bool finished() const { return done.load() == JOB_COUNT; }
+    float progress() const { return (float)done.load() / JOB_COUNT; }
+    unsigned workers() const { return pool ? pool->size() : 0; }
+    double wallMs() const { return elapsedMs(startTime); }
 
-class Bird {
-public:
-    sf::Sprite sprite;    
-    sf::Vector2f position;
-    sf::Clock wingClock;  
-    sf::Texture wingUpTex, wingDownTex; 
-    bool showWingUp;      
-
-    Bird(const sf::Texture& wu, const sf::Texture& wd) : wingUpTex(wu), wingDownTex(wd), showWingUp(true) {}
-
-    void init(float x, float y) { 
-        position = sf::Vector2f(x, y); 
-        sprite.setTexture(showWingUp ? wingUpTex : wingDownTex); 
-        sprite.setPosition(position); 
+    static const char* jobName(int i) {
+        if (i < SPR_COUNT) return SPRITE_FILES[i];
+        return i == JOB_FONT ? "Roboto-Regular.ttf" : "sfx (synth)";
     }
 
-    void update(float s, float dt) {
-        position.x -= s; 
-        sprite.setPosition(position);
-        if (wingClock.getElapsedTime().asSeconds() > 0.25f) { 
-            showWingUp = !showWingUp; 
-            sprite.setTexture(showWingUp ? wingUpTex : wingDownTex); 
-            wingClock.restart(); 
+    void release() { pool.reset(); } // 全部完成后回收线程
+
+private:
+    void runJob(int i) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        const BundleEntry* be = bundle.find(jobName(i));
+        if (i < SPR_COUNT) {
+            if (be && be->kind == BUNDLE_RGBA) { // 预解码像素：跳过 PNG 解压，直接引用映射区
+                sources[i] = SpriteSource(bundle.data(*be), be->width, be->height);
+                ok[i] = true;
+            } else {
+                ok[i] = be ? images[i].loadFromMemory(bundle.data(*be), (size_t)be->size) 
+                           : !bundle.isOpen() && images[i].loadFromFile(SPRITE_FILES[i]);
+                if (ok[i]) sources[i] = SpriteSource(images[i].getPixelsPtr(), images[i].getSize().x, images[i].getSize().y);
+            }
+            if (ok[i]) spriteMasks[i].build(sources[i].pixels, (int)sources[i].width, (int)sources[i].height);
         }
+        else if (i == JOB_FONT) {
+            if (be) { fontPtr = bundle.data(*be); fontSize = (size_t)be->size; }
+            else if (!bundle.isOpen()) {
+                std::ifstream in("Roboto-Regular.ttf", std::ios::binary);
+                if (in.is_open()) fontData.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+                fontPtr = fontData.data(); fontSize = fontData.size();
+            }
+            ok[i] = fontSize > 0;
+        }
+        else {
+            ok[i] = true;
+            for (int k = 0; k < SFX_COUNT; ++k) { // 程序化合成，不读写磁盘
+                std::chrono::steady_clock::time_point s0 = std::chrono::steady_clock::now();
+                synthRender((SfxId)k, sfxSamples[k]);
+                sfxMs[k] = elapsedMs(s0);
+                ok[i] &= !sfxSamples[k].empty();
+            }
+        }
+        decodeMs[i] = elapsedMs(t0);
+        done.fetch_add(1); // 之前的写入对读取 finished() 的线程可见
     }
 
-    bool checkCollision(const sf::FloatRect& o) const { 
-        sf::FloatRect b = sprite.getGlobalBounds(); 
-        return sf::FloatRect(b.left+5, b.top+5, b.width-10, b.height-10).intersects(o); 
-    }
-
-    bool isOffScreen() const { return position.x + sprite.getGlobalBounds().width < 0; }
-    
-    void draw(sf::RenderWindow& w) { w.draw(sprite); }
+    std::unique_ptr<WorkerPool> pool;
+    std::atomic<int> done;
+    std::chrono::steady_clock::time_point startTime;
 };
 
-// ==========================================
-// 资源加载和全局变量
-// ==========================================
-sf::Texture tDino1, tDino2, tJump, tCacL, tCacS1, tCacS2, tCoin, tTrack, tBirdU, tBirdD;
-sf::Font font; 
-sf::SoundBuffer shutBuf; 
-sf::Sound shutSound; 
-sf::Music bgm;
+// 渲染线程：把解码结果上传为纹理/字体/音频，并输出每个资源的耗时
+bool loadAssets(AssetLoader& l) {
+    for (int i = 0; i < AssetLoader::JOB_COUNT; ++i) 
+        if (!l.ok[i]) { std::cerr << "Missing asset: " << AssetLoader::jobName(i) << "\n"; return false; }
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    if (!resources.loadSprites(l.sources)) return false; // 图集是唯一一次纹理上传
+    double atlasMs = elapsedMs(t0);
 
-bool loadAssets() {
     bool ok = true;
-    ok &= tDino1.loadFromFile("DinoRun1.png"); ok &= tDino2.loadFromFile("DinoRun2.png"); ok &= tJump.loadFromFile("DinoJump.png");
-    ok &= tCacL.loadFromFile("LargeCactus1.png"); ok &= tCacS1.loadFromFile("SmallCactus1.png"); ok &= tCacS2.loadFromFile("SmallCactus2.png");
-    ok &= tCoin.loadFromFile("Coin.png"); ok &= tTrack.loadFromFile("Track.png");
-    ok &= tBirdU.loadFromFile("BirdWingUp.png"); ok &= tBirdD.loadFromFile("BirdWingDown.png");
-    ok &= font.loadFromFile("Roboto-Regular.ttf"); ok &= shutBuf.loadFromFile("shutdown.wav");
-    bgm.openFromFile("bgm.ogg"); bgm.setLoop(true); shutSound.setBuffer(shutBuf);
+    t0 = std::chrono::steady_clock::now();
+    ok &= font.loadFromMemory(l.fontPtr, l.fontSize); 
+    double fontMs = elapsedMs(t0);
+    t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < SFX_COUNT; ++k) 
+        ok &= sfxBuf[k].loadFromSamples(reinterpret_cast<const sf::Int16*>(l.sfxSamples[k].data()), l.sfxSamples[k].size(), 1, SYNTH_SAMPLE_RATE);
+    double soundMs = elapsedMs(t0);
+    const BundleEntry* music = bundle.find("bgm.ogg"); // BGM 可选，与原先一致
+    if (music) bgm.openFromMemory(bundle.data(*music), (size_t)music->size);
+    else if (!bundle.isOpen()) bgm.openFromFile("bgm.ogg");
+    bgm.setLoop(true); 
+    shutSound.setBuffer(sfxBuf[SFX_SHUTDOWN]); coinSound.setBuffer(sfxBuf[SFX_COIN]);
+    jumpSound.setBuffer(sfxBuf[SFX_JUMP]); milestoneSound.setBuffer(sfxBuf[SFX_MILESTONE]);
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (int i = 0; i < AssetLoader::JOB_COUNT; ++i)
+        std::cout << "[assets] " << std::left << std::setw(20) << AssetLoader::jobName(i) << std::right << " decode " << std::setw(7) << l.decodeMs[i] << " ms\n";
+    for (int k = 0; k < SFX_COUNT; ++k)
+        std::cout << "[assets]   synth " << std::left << std::setw(12) << sfxName((SfxId)k) << std::right << std::setw(7) << l.sfxMs[k] << " ms (" << l.sfxSamples[k].size() << " samples)\n";
+    std::cout << "[assets] upload: atlas " << atlasMs << " ms, font " << fontMs << " ms, sound " << soundMs << " ms\n";
+    std::cout << "[assets] total " << l.wallMs() << " ms on " << l.workers() << " workers\n";
     return ok;
 }
 
@@ -339,80 +416,240 @@ bool loadAssets() {
 // 存档系统
 // ==========================================
 
-void saveGame(float d, int c, const Dino& dn, const std::vector<Cactus>& ca, const std::vector<Coin>& co, const std::vector<Bird>& bi) {
-    std::ofstream out("savegame.txt");
-    if (out.is_open()) {
-        out << d << " " << c << "\n"; 
-        out << dn.sprite.getPosition().y << " " << dn.velocity.y << " " << dn.onGround << "\n"; 
-        out << ca.size() << "\n"; for(size_t i=0; i<ca.size(); ++i) out << ca[i].position.x << " " << ca[i].type << "\n";
-        int vc=0; for(size_t i=0; i<co.size(); ++i) if(!co[i].collected) vc++; out << vc << "\n";
-        for(size_t i=0; i<co.size(); ++i) if(!co[i].collected) out << co[i].position.x << " " << co[i].position.y << "\n";
-        out << bi.size() << "\n"; for(size_t i=0; i<bi.size(); ++i) out << bi[i].position.x << " " << bi[i].position.y << "\n";
-        out.close();
-    }
+// 存档格式见 SaveFile.h：定长二进制 + CRC，先写临时文件再改名；写入由 PersistWorker 在后台完成
+bool loadGame(GameWorld& w, int slot) {
+    return readSave(slotPath(slot), w); // 失败（没有存档、损坏、版本不符）时世界不变
 }
 
-bool loadGame(float& d, int& c, Dino& dn, std::vector<Cactus>& ca, std::vector<Coin>& co, std::vector<Bird>& bi) {
-    std::ifstream in("savegame.txt"); if (!in.is_open()) return false;
-    ca.clear(); co.clear(); bi.clear(); 
-    in >> d >> c; 
-    float dy, dvy; bool dog; in >> dy >> dvy >> dog; 
-    dn.sprite.setPosition(50, dy); dn.velocity.y = dvy; dn.onGround = dog;
-    int cnt; in >> cnt; sf::Texture* ts[3]; ts[0]=&tCacL; ts[1]=&tCacS1; ts[2]=&tCacS2;
-    for(int i=0; i<cnt; ++i) { float x; int t; in >> x >> t; Cactus o; o.init(x, t, *ts[t%3]); ca.push_back(o); }
-    in >> cnt; for(int i=0; i<cnt; ++i) { float x,y; in >> x >> y; Coin o; o.init(x, y, tCoin); co.push_back(o); }
-    in >> cnt; for(int i=0; i<cnt; ++i) { float x,y; in >> x >> y; Bird o(tBirdU, tBirdD); o.init(x, y); bi.push_back(o); }
-    in.close(); return true;
+// 存档位卡片上的时间
+std::string formatSaveTime(int64_t t) {
+    std::time_t tt = (std::time_t)t;
+    const std::tm* lt = std::localtime(&tt);
+    char buf[32];
+    if (!lt || !std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M", lt)) return "";
+    return buf;
 }
 
-void generateShutdownWav() {
-    const int sr = 44100; const double dur = 0.5; std::vector<short> s(sr * dur);
-    for (size_t i = 0; i < s.size(); ++i) s[i] = static_cast<short>(10000 * sin(2 * 3.14159 * 440 * i / sr)); 
-    std::ofstream f("shutdown.wav", std::ios::binary);
-    int sz = s.size() * 2; int h[11] = {0x46464952, 36+sz, 0x45564157, 0x20746d66, 16, 0x10001, 44100, 44100*2, 0x100002, 0x61746164, sz}; 
-    f.write((char*)h, 44); f.write((char*)s.data(), sz);
+// ==========================================
+// 场景绘制
+// ==========================================
+
+// 图集里的实际尺寸，决定模拟中的碰撞框
+SpriteMetrics atlasMetrics(const TextureAtlas& a) {
+    SpriteMetrics m;
+    for (int i = 0; i < SPR_COUNT; ++i) { m.w[i] = (int)a.size[i].x; m.h[i] = (int)a.size[i].y; }
+    return m;
+}
+
+// 把世界状态拼进批次；alpha 为两步之间的插值系数，obstaclesOnly 用于结算画面
+void drawWorld(SpriteBatch& batch, const GameWorld& w, float alpha, bool obstaclesOnly = false) {
+    float shift = w.lastScroll * (1.0f - alpha);
+    batch.add(SPR_TRACK, sf::Vector2f(w.groundX[0] + shift, GROUND_Y + 30)); 
+    batch.add(SPR_TRACK, sf::Vector2f(w.groundX[1] + shift, GROUND_Y + 30)); 
+    batch.add(w.dinoSprite(), sf::Vector2f(DINO_X, lerp(w.dino.prevY, w.dino.y, alpha))); 
+    const EntityList& ca = w.cacti; const EntityList& co = w.coinList; const EntityList& bi = w.birds;
+    for(unsigned i=0; i<ca.size(); ++i) { 
+        unsigned s = ca.slot(i);
+        batch.add((SpriteId)(SPR_CACTUS_L + ca.type[s]), sf::Vector2f(lerp(ca.prevX[s], ca.x[s], alpha), ca.y[s])); 
+    }
+    if (obstaclesOnly) return;
+    for(unsigned i=0; i<co.size(); ++i) { 
+        unsigned s = co.slot(i);
+        if (!co.flag[s]) batch.add(SPR_COIN, sf::Vector2f(lerp(co.prevX[s], co.x[s], alpha), co.y[s])); 
+    }
+    for(unsigned i=0; i<bi.size(); ++i) { 
+        unsigned s = bi.slot(i);
+        batch.add(bi.flag[s] ? SPR_BIRD_UP : SPR_BIRD_DOWN, sf::Vector2f(lerp(bi.prevX[s], bi.x[s], alpha), bi.y[s])); 
+    }
+}
+
+// 每局的随机种子（录像里只记这一个数）
+uint32_t newRunSeed() {
+    return ((uint32_t)std::rand() << 16) ^ (uint32_t)std::rand() ^ (uint32_t)std::time(0);
 }
 
 // ==========================================
 // 主函数
 // ==========================================
-int main() {
+int main(int argc, char** argv) {
     std::srand((unsigned int)std::time(0)); 
+
+    // --replay <文件>：启动后直接回放录像；--bot：机器人自动玩，死亡后自动开下一局（挂机测试）；
+    // --journal：游戏中每秒写自动存档日志，崩溃或断电后下次启动可继续（展台机用）
+    std::string replayPath;
+    bool soak = false;
+    bool journaling = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--replay" && i + 1 < argc) replayPath = argv[i + 1];
+        if (std::string(argv[i]) == "--bot") soak = true;
+        if (std::string(argv[i]) == "--journal") journaling = true;
+    }
+    ReplayPlayer player;
+    if (!replayPath.empty() && !player.load(replayPath)) { std::cerr << "Cannot read replay " << replayPath << "\n"; return -1; }
     
     std::vector<std::string> team;
     team.push_back("Game Created By");
     team.push_back("Yao Wang");
     team.push_back("Solo Developer");
 
-    { std::ifstream c("shutdown.wav"); if(!c.is_open()) generateShutdownWav(); } // 确保 shutdown.wav 存在后再加载资源
-    if (!loadAssets()) { std::cerr << "Asset Error\n"; return -1; }
+    // 优先使用打包好的 Game.pak；缺少任何必需资源都在开始游戏前直接失败（窗口都不会打开）
+    if (bundle.open("Game.pak")) {
+        for (int i = 0; i < AssetLoader::JOB_SFX; ++i)
+            if (!bundle.find(AssetLoader::jobName(i))) { std::cerr << "Game.pak is missing " << AssetLoader::jobName(i) << "\n"; return -1; }
+    }
 
+    // 先开窗口，资源在后台解码，期间显示进度条
     sf::RenderWindow window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Little Dino - Final");
-    window.setFramerateLimit(60); 
+    window.setVerticalSyncEnabled(true); // 渲染跟随显示器刷新率，模拟步长与之无关
 
     sf::View gameView(sf::FloatRect(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT));
     window.setView(gameView);
 
-    int highScore = 0;
-    int highCoins = 0;
-    loadHighData(highScore, highCoins);
+    AssetLoader loader; 
+    loader.start();
+    while (window.isOpen() && !loader.finished()) {
+        sf::Event e;
+        while (window.pollEvent(e)) if (e.type == sf::Event::Closed) window.close();
+        window.clear(UI_BG);
+        drawLoadingBar(window, loader.progress());
+        window.display();
+    }
+    loader.release(); // 窗口被关掉时也要等工作线程结束
+    if (!window.isOpen()) return 0;
+    if (!loadAssets(loader)) { std::cerr << "Asset Error\n"; return -1; }
 
     GameState state = MENU; 
-    float dist = 0.0f; int coins = 0; float spd = 0.0f; 
-    float spawnTimer=0, coinSpawnTimer=0, birdTimer=0;  
-    bool paused = false; bool savedMsg = false; sf::Clock msgClk; 
+    bool paused = false; bool savedMsg = false; bool saveFailed = false; sf::Clock msgClk; 
+    PersistWorker persist; // 存档、战绩在后台线程写盘，帧线程只交出快照
+
+    Leaderboard board; // 只读定长索引与少量尾部记录，与累计局数无关
+    persist.loadRuns(board);
+    int highScore = board.bestScore();
+    int highCoins = board.bestCoins();
     
     int countdownVal = 3;
     float countdownTime = 0.0f;
 
-    Dino dino(tDino1, tDino2, tJump);
-    std::vector<Cactus> cacti; std::vector<Coin> coinList; std::vector<Bird> birds;
-    sf::Sprite g1(tTrack), g2(tTrack); 
-    g1.setPosition(0, GROUND_Y + 30); g2.setPosition(tTrack.getSize().x, GROUND_Y + 30);
+    sf::Clock frameClock; float accumulator = 0.0f; // 固定步长累加器
+    bool pendingJump = false; // 事件里按下的跳跃，留给下一步模拟消费
+
+    TrackFeed trackFeed; // 在 world 之前构造、之后析构
+    GameWorld world(atlasMetrics(resources.getAtlas()));
+    world.setMasks(spriteMasks); // 障碍物按像素判定碰撞
+    world.setFeed(&trackFeed);   // 赛道在工作线程上提前数秒生成，帧内只取用
+
+    // 按 O 把训练用的低分辨率观测帧（ObsFrame.h）放大叠在画面上，核对两者摆放一致；
+    // 观测帧取本步位置，画面按插值绘制，暂停时两者完全重合
+    FrameRenderer obsRenderer(160, 80, world.metrics, spriteMasks);
+    std::vector<uint8_t> obsGray((size_t)obsRenderer.width() * obsRenderer.height());
+    std::vector<sf::Uint8> obsRgba(obsGray.size() * 4);
+    sf::Texture obsTex; obsTex.create(obsRenderer.width(), obsRenderer.height());
+    bool obsOverlay = false;
+
+    ReplayRecorder recorder;
+    bool recording = false;     // 当前这局从头开始录（读档的局不录）
+    bool resumed = false;       // 暂停后刚恢复，下一步的输入带上 RIN_PAUSE
+    bool watching = false;      // 正在回放录像，键盘不再控制恐龙
+    bool replayCountdown = false; // 录像里的暂停点已经倒计时过
+    SearchBot bot;
+    bool botPlaying = soak;     // 输入来自机器人（游戏中按 B 切换）
+    bool botUsed = false;       // 本局机器人操作过，不计入最高分
+    sf::Clock gameOverClk;      // 挂机模式下结算画面停留的时间
+    RewindBuffer rewind;        // 最近十几秒的历史（Rewind.h），死亡后按住 ← 倒回
+    GameWorld rewindView(world.metrics); // 倒回时显示的局面，不带 feed
+    float rewindCursor = 0;     // 倒回到的步号
+    bool rewound = false;       // 本局倒回过，不计入最高分
+    bool newHs = false, newHc = false; // 本局结算时严格超过了此前的纪录（机器人、倒回过、回放的局都不算）
+    bool perfOverlay = false;   // F3：帧率与回退缓冲占用
+    float fpsAvg = 60.0f;
+    JournalBatcher journal;     // --journal 时本局的自动存档批次
+
+    // 自动存档日志：开局、读档、从倒回处继续时先写检查点；死亡或回到菜单时删除
+    auto journalBegin = [&]() {
+        if (!journaling) return;
+        persist.journalCheckpoint(world); journal.begin(world);
+    };
+    auto journalEnd = [&]() {
+        if (!journal.active()) return;
+        persist.journalDiscard(); journal.stop();
+    };
+
+    // 存档位：列表只读映射的索引（SaveFile.h），选中读档时才打开对应的存档文件
+    SlotIndex slotIndex;
+    SlotInfo slotInfo[SAVE_SLOTS];
+    bool slotUsed[SAVE_SLOTS];
+    sf::Texture slotTex[SAVE_SLOTS];
+    for (int i = 0; i < SAVE_SLOTS; ++i) { slotUsed[i] = false; slotTex[i].create(SLOT_THUMB_W, SLOT_THUMB_H); }
+    std::vector<sf::Uint8> slotRgba((size_t)SLOT_THUMB_W * SLOT_THUMB_H * 4);
+    FrameRenderer thumbRenderer(SLOT_THUMB_W, SLOT_THUMB_H, world.metrics, spriteMasks); // 存档时的缩略图
+    std::vector<uint8_t> thumbGray((size_t)SLOT_THUMB_W * SLOT_THUMB_H);
+    bool slotsForSave = false;  // 存档位列表是存档（否则读档）
+    int saveSlot = 0;           // K 快速存档写入的存档位：上次存/读的那个
+
+    // 从头开始新的一局并开始录像
+    auto startRun = [&]() {
+        state = PLAYING; world.setMasks(spriteMasks); world.reset(newRunSeed()); pendingJump = false; bgm.play();
+        recorder.begin(world.seed, REPLAY_PIXEL_COLLISION); recording = true; resumed = false; watching = false;
+        bot.reset(); botUsed = botPlaying;
+        rewind.begin(world); rewound = false;
+        journalBegin();
+    };
+
+    if (!replayPath.empty()) {
+        world.setMasks((player.flags() & REPLAY_PIXEL_COLLISION) ? spriteMasks : 0);
+        world.reset(player.seed());
+        watching = true; replayCountdown = false;
+        state = PLAYING; bgm.play();
+    }
+    else if (soak) startRun();
+    else if (journaling) {
+        world.setMasks(spriteMasks);
+        if (recoverJournal(world)) state = RECOVER; // 上次崩溃前的局面，等玩家确认
+        else persist.journalDiscard(); // 损坏或那一局其实已经结束：删掉，免得每次启动都重新读
+    }
+
+    // 重新映射索引并上传缩略图；打开列表和存档落盘时调用
+    auto refreshSlots = [&]() {
+        slotIndex.open();
+        for (int i = 0; i < SAVE_SLOTS; ++i) {
+            slotUsed[i] = slotIndex.read(i, slotInfo[i]);
+            if (!slotUsed[i]) continue;
+            for (size_t k = 0; k < thumbGray.size(); ++k) { // 灰度作为深色的不透明度，叠在卡片上
+                slotRgba[k * 4] = UI_TEXT_DARK.r; slotRgba[k * 4 + 1] = UI_TEXT_DARK.g; slotRgba[k * 4 + 2] = UI_TEXT_DARK.b;
+                slotRgba[k * 4 + 3] = slotInfo[i].thumb[k];
+            }
+            slotTex[i].update(slotRgba.data());
+        }
+    };
+    auto openSlots = [&](bool forSave) { refreshSlots(); slotsForSave = forSave; state = SLOTS; };
+    auto saveToSlot = [&](int i) {
+        thumbRenderer.render(world, thumbGray.data());
+        persist.saveGame(world, i, thumbGray.data()); // 落盘后才提示
+        saveSlot = i;
+    };
+    // 读档或恢复日志后：不录像，回退与自动存档从这里重新开始
+    auto resumeLoaded = [&]() {
+        recording = false; watching = false;
+        rewind.begin(world); rewound = false;
+        journalBegin();
+        state = COUNTDOWN; // 读档后通过倒计时回到游戏，避免突兀
+        countdownVal = 3; 
+        countdownTime = 0.0f; 
+        paused = false; pendingJump = false; 
+        bgm.play(); 
+    };
+    auto loadSlot = [&](int i) {
+        world.setMasks(spriteMasks);
+        if (!slotUsed[i] || !loadGame(world, i)) return;
+        saveSlot = i;
+        resumeLoaded();
+    };
+    SpriteBatch batch(resources.getAtlas());
 
     std::vector<std::string> menu;
     menu.push_back("Start Adventure");
     menu.push_back("Load Save");
+    menu.push_back("Leaderboard");
     menu.push_back("How to Play");
     menu.push_back("Credits");
     menu.push_back("Exit");
@@ -423,11 +660,11 @@ int main() {
     pauseMenu.push_back("Main Menu");
 
     while (window.isOpen()) {
-        float dt = 1.0f / 60.0f; // 固定帧时间，便于统一物理更新
         sf::Event e;
         
         while (window.pollEvent(e)) {
             if (e.type == sf::Event::Closed) window.close(); 
+            if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::F3) perfOverlay = !perfOverlay;
             
             if (e.type == sf::Event::Resized) {
                 gameView.reset(sf::FloatRect(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT)); // 强制保持设计尺寸
@@ -440,30 +677,17 @@ int main() {
             // --- 菜单逻辑优化 ---
             if (state == MENU) {
                 if (e.type == sf::Event::MouseButtonPressed && e.mouseButton.button == sf::Mouse::Left) {
-                    for (int i = 0; i < 5; ++i) {
+                    for (int i = 0; i < 6; ++i) {
                         // 计算按钮的矩形起始位置和宽高
                         float bx = WINDOW_WIDTH/2 - 110; 
-                        float by = 140 + i * 46; // 略微下移按钮保持间距
+                        float by = 120 + i * 44;
                         if (worldPos.x > bx && worldPos.x < bx+220 && worldPos.y > by && worldPos.y < by+40) {
-                            if (i==0) { 
-                                state=PLAYING; dist=0; coins=0; dino=Dino(tDino1, tDino2, tJump); 
-                                cacti.clear(); coinList.clear(); birds.clear(); 
-                                spd=4.0f*SPEED_MULTIPLIER; bgm.play(); 
-                            }
-                            else if (i==1) { 
-                                if(loadGame(dist, coins, dino, cacti, coinList, birds)) { 
-                                    state = COUNTDOWN; // 读档后通过倒计时回到游戏，避免突兀
-                                    countdownVal = 3; 
-                                    countdownTime = 0.0f; 
-                                    paused = false; 
-                                    spd = 4.0f*SPEED_MULTIPLIER+(dist/100.0f)*0.8f; // 依行进距离恢复速度
-                                    if(spd>MAX_SPEED) spd=MAX_SPEED; 
-                                    bgm.play(); 
-                                } 
-                            }
-                            else if (i==2) state=INTRO; 
-                            else if (i==3) state=ABOUT; 
-                            else if (i==4) window.close(); 
+                            if (i==0) startRun();
+                            else if (i==1) openSlots(false); // 先列出存档位，选中后才读档
+                            else if (i==2) state=LEADERBOARD; 
+                            else if (i==3) state=INTRO; 
+                            else if (i==4) state=ABOUT; 
+                            else if (i==5) window.close(); 
                         }
                     }
                 }
@@ -475,18 +699,20 @@ int main() {
                         if (!paused) {
                             paused = true; 
                         } else {
-                            paused = false;
+                            paused = false; resumed = true;
                             state = COUNTDOWN; // 继续前加 3 秒倒计时
                             countdownVal = 3;
                             countdownTime = 0.0f;
                         }
                     }
-                    if (e.key.code == sf::Keyboard::Escape) { state = MENU; bgm.stop(); } 
-                    if (paused && e.key.code == sf::Keyboard::K) { 
-                        saveGame(dist, coins, dino, cacti, coinList, birds); // 暂停时按 K 快速存档
-                        savedMsg = true; msgClk.restart(); 
+                    if (e.key.code == sf::Keyboard::Escape) { state = MENU; bgm.stop(); watching = false; journalEnd(); } 
+                    if (paused && e.key.code == sf::Keyboard::K) saveToSlot(saveSlot); // 暂停时按 K 快速存到上次的存档位
+                    if (e.key.code == sf::Keyboard::O) obsOverlay = !obsOverlay;
+                    if (!paused && !watching && e.key.code == sf::Keyboard::B) { // 切换机器人 / 键盘操作
+                        botPlaying = !botPlaying;
+                        if (botPlaying) { bot.reset(); botUsed = true; }
                     }
-                    if (!paused && isJumpKey(e.key.code)) dino.jump();
+                    if (!paused && !watching && isJumpKey(e.key.code)) pendingJump = true; 
                 }
                 
                 if (paused && e.type == sf::Event::MouseButtonPressed && e.mouseButton.button == sf::Mouse::Left) {
@@ -496,36 +722,71 @@ int main() {
                         float by = 155 + i * 50;
                         if (worldPos.x > bx && worldPos.x < bx+220 && worldPos.y > by && worldPos.y < by+40) {
                             if (i == 0) { 
-                                paused = false; 
+                                paused = false; resumed = true;
                                 state = COUNTDOWN; 
                                 countdownVal = 3; 
                                 countdownTime = 0.0f; 
                             } 
-                            else if (i == 1) { 
-                                saveGame(dist, coins, dino, cacti, coinList, birds); 
-                                savedMsg = true; msgClk.restart(); 
-                            }
-                            else if (i == 2) { state = MENU; bgm.stop(); } 
+                            else if (i == 1) openSlots(true); 
+                            else if (i == 2) { state = MENU; bgm.stop(); watching = false; journalEnd(); } 
                         }
                     }
                 }
             }
             else if (state == COUNTDOWN) {
                  if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::Escape) {
-                     state = MENU; bgm.stop();
+                     state = MENU; bgm.stop(); watching = false; journalEnd();
                  }
             }
-            else if (state == INTRO || state == ABOUT) {
+            else if (state == SLOTS) {
+                int pick = -1;
+                if (e.type == sf::Event::KeyPressed) {
+                    if (e.key.code == sf::Keyboard::Escape) state = slotsForSave ? PLAYING : MENU; // 存档时回到暂停菜单
+                    else if (e.key.code >= sf::Keyboard::Num1 && e.key.code < sf::Keyboard::Num1 + SAVE_SLOTS) pick = e.key.code - sf::Keyboard::Num1;
+                }
+                if (e.type == sf::Event::MouseButtonPressed && e.mouseButton.button == sf::Mouse::Left) {
+                    for (int i = 0; i < SAVE_SLOTS; ++i) {
+                        float bx = 40 + i * 185; float by = 100;
+                        if (worldPos.x > bx && worldPos.x < bx+165 && worldPos.y > by && worldPos.y < by+210) pick = i;
+                    }
+                }
+                if (pick >= 0 && slotsForSave) { saveToSlot(pick); state = PLAYING; } // 回到暂停菜单显示写盘进度
+                else if (pick >= 0) loadSlot(pick);
+            }
+            else if (state == RECOVER) {
+                if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::Return) resumeLoaded();
+                else if (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::Escape) { persist.journalDiscard(); state = MENU; }
+            }
+            else if (state == INTRO || state == ABOUT || state == LEADERBOARD) {
                 if (e.type == sf::Event::KeyPressed && (e.key.code == sf::Keyboard::Escape || e.key.code == sf::Keyboard::Return)) state = MENU;
             }
             else if (state == GAME_OVER) {
                 if (e.type == sf::Event::KeyPressed) {
-                    if (e.key.code == sf::Keyboard::R) { 
-                        state=PLAYING; dist=0; coins=0; dino=Dino(tDino1, tDino2, tJump); 
-                        cacti.clear(); coinList.clear(); birds.clear(); 
-                        spd=4.0f*SPEED_MULTIPLIER; bgm.play(); 
+                    if (e.key.code == sf::Keyboard::R && watching) { // 回放结束后按 R 从头再看一遍
+                        state=PLAYING; player.rewind(); world.reset(player.seed()); replayCountdown = false; bgm.play();
+                    }
+                    else if (e.key.code == sf::Keyboard::R) startRun();
+                    else if (e.key.code == sf::Keyboard::Left && !watching && !rewind.empty()) { // 开始倒回，从死亡那一步起
+                        state = REWIND; rewindCursor = (float)rewind.lastTick();
+                        rewindView.setMasks(world.masks); rewindView.setDifficulty(world.difficulty);
+                        rewind.seek(rewind.lastTick(), rewindView);
+                    }
+                    else if (e.key.code == sf::Keyboard::Escape) { state = MENU; watching = false; } 
+                }
+            }
+            else if (state == REWIND) {
+                if (e.type == sf::Event::KeyPressed) {
+                    if (e.key.code == sf::Keyboard::Escape) state = GAME_OVER; // 放弃倒回，回到结算
+                    else if (e.key.code == sf::Keyboard::Return || e.key.code == sf::Keyboard::Space) { // 从这一步继续
+                        uint32_t t = (uint32_t)rewindCursor;
+                        rewind.seek(t, rewindView);
+                        world.restore(rewindView); // 赛道从这一步接着生成，与没死时完全相同
+                        rewind.truncate(t);
+                        rewound = true; recording = false; bot.reset();
+                        journalBegin();
+                        state = COUNTDOWN; countdownVal = 3; countdownTime = 0.0f;
+                        paused = false; pendingJump = false; bgm.play();
                     }
-                    else if (e.key.code == sf::Keyboard::Escape) state = MENU; 
                 }
             }
         }
@@ -533,94 +794,100 @@ int main() {
         sf::Vector2i pixelPos = sf::Mouse::getPosition(window);
         sf::Vector2f worldPos = window.mapPixelToCoords(pixelPos);
 
-        // --- 更新时间 ---
+        bool saveOk;
+        if (persist.pollSaved(saveOk)) { savedMsg = true; saveFailed = !saveOk; msgClk.restart(); refreshSlots(); } // 存档已落盘（或失败）
 
-        if (state == COUNTDOWN) {
-            countdownTime += dt;
-            if (countdownTime >= 1.0f) { 
-                countdownVal--;
-                countdownTime = 0.0f;
-            }
-            if (countdownVal <= 0) { 
-                state = PLAYING; 
+        if (soak && state == GAME_OVER && !watching && gameOverClk.getElapsedTime().asSeconds() > 2.0f) startRun();
+
+        // --- 更新时间（固定步长，与渲染帧率解耦） ---
+
+        float frameTime = frameClock.restart().asSeconds();
+        if (frameTime > 0) fpsAvg += (1.0f / frameTime - fpsAvg) * 0.05f;
+        if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+        if (state == COUNTDOWN || (state == PLAYING && !paused)) accumulator += frameTime; 
+        else accumulator = 0.0f;
+
+        if (state == REWIND) { // 按住 ← / → 在历史中移动，每帧只需恢复一个关键帧再模拟不到半秒
+            float dir = (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) ? -1.0f : 0.0f) + (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) ? 1.0f : 0.0f);
+            if (dir != 0) {
+                rewindCursor += dir * REWIND_SCRUB_SPEED * frameTime / SIM_DT;
+                if (rewindCursor < (float)rewind.firstTick()) rewindCursor = (float)rewind.firstTick();
+                if (rewindCursor > (float)rewind.lastTick()) rewindCursor = (float)rewind.lastTick();
+                rewind.seek((uint32_t)rewindCursor, rewindView);
             }
         }
-        else if (state == PLAYING && !paused) {
-            dino.update(dt); 
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) dino.fallFaster(); // 长按下加速下落
-
-            dist += spd * dt;
-            float target = 4.0f * SPEED_MULTIPLIER + (dist / 100.0f) * 0.8f; // 距离越远速度越快
-            if (target > MAX_SPEED) target = MAX_SPEED; // 限制最大速度
-            spd = target;
-            
-            spawnTimer += dt;
-            if (spawnTimer > 1.5f + (rand()%15)/10.0f) { // 随机生成仙人掌，间隔 1.5~3.0s
-                Cactus c; sf::Texture* ts[3]; ts[0]=&tCacL; ts[1]=&tCacS1; ts[2]=&tCacS2; int t = rand()%3;
-                if (c.init(WINDOW_WIDTH + 20, t, *ts[t])) cacti.push_back(c); 
-                spawnTimer = 0;
-            }
-            
-            coinSpawnTimer += dt;
-            if (coinSpawnTimer > 3.0f + (rand() % 20) / 10.0f) { // 约 3~5 秒尝试刷一枚硬币
-                if (rand() % 100 < 50) { // 50% 概率生成，避免过密
-                    Coin c; 
-                    bool safe = true; 
-                    float cx = WINDOW_WIDTH + 100 + rand() % 100; // 生成在屏外 100~200 像素
-                    
-                    for(size_t i = 0; i < cacti.size(); ++i) if(std::abs(cacti[i].position.x - cx) < 100) safe = false; // 与仙人掌保持距离
-                    for(size_t i = 0; i < birds.size(); ++i) if(std::abs(birds[i].position.x - cx) < 100) safe = false; // 与飞鸟保持距离
-
-                    if(safe) {
-                        if(c.init(cx, 90.0f, tCoin)) coinList.push_back(c); 
-                    }
-                } 
-                coinSpawnTimer = 0;
-            }
 
-            if (dist > MIN_BIRD_SPAWN_DISTANCE) { // 距离超过一定值后才刷飞鸟
-                birdTimer += dt; 
-                if (birdTimer > 4.0f) { // 每 4 秒尝试刷一只
-                    float birdSpawnX = WINDOW_WIDTH + 50;
-                    bool safe = true;
-                    for(size_t i = 0; i < coinList.size(); ++i) if(std::abs(coinList[i].position.x - birdSpawnX) < 100) safe = false; // 与硬币保持间隔
-                    for(size_t i = 0; i < cacti.size(); ++i) if(std::abs(cacti[i].position.x - birdSpawnX) < 80) safe = false;  // 与仙人掌保持间隔
-
-                    if (safe) {
-                        Bird b(tBirdU, tBirdD); b.init(birdSpawnX, 130.0f); birds.push_back(b); birdTimer = 0; 
-                    } else { birdTimer = 3.5f; } 
+        while (accumulator >= SIM_DT && (state == COUNTDOWN || (state == PLAYING && !paused))) {
+            accumulator -= SIM_DT;
+            const float dt = SIM_DT;
+            if (state == COUNTDOWN) {
+                countdownTime += dt;
+                if (countdownTime >= 1.0f) { 
+                    countdownVal--;
+                    countdownTime = 0.0f;
+                }
+                if (countdownVal <= 0) { 
+                    state = PLAYING; 
                 }
             }
-
-            for(size_t i=0; i<cacti.size(); ++i) cacti[i].update(spd);
-            for(size_t i=0; i<coinList.size(); ++i) coinList[i].update(spd);
-            for(size_t i=0; i<birds.size(); ++i) birds[i].update(spd, dt);
-
-            sf::FloatRect pr = dino.getBounds();
-            bool collision = false;
-            for(size_t i=0; i<cacti.size(); ++i) if (cacti[i].checkCollision(pr)) collision = true; // 碰到仙人掌
-            for(size_t i=0; i<birds.size(); ++i) if (birds[i].checkCollision(pr)) collision = true; // 碰到飞鸟
-            
-            if (collision) {
-                state = GAME_OVER; bgm.stop(); shutSound.play();
-                int currentScore = (int)(dist * SCORE_MULTIPLIER);
-                bool updated = false;
-                if (currentScore > highScore) { highScore = currentScore; updated = true; }
-                if (coins > highCoins) { highCoins = coins; updated = true; }
-                if (updated) saveHighData(highScore, highCoins);
+            else if (state == PLAYING && !paused) {
+                WorldInput in;
+                if (watching) {
+                    if (player.finished()) { state = GAME_OVER; bgm.stop(); break; } // 录像在死亡前就结束了
+                    if ((player.peek() & RIN_PAUSE) && !replayCountdown) { // 录制时在这里暂停过，同样倒计时
+                        state = COUNTDOWN; countdownVal = 3; countdownTime = 0.0f; replayCountdown = true;
+                        continue;
+                    }
+                    replayCountdown = false;
+                    in = replayInput(player.next());
+                } else if (botPlaying) {
+                    in = bot.think(world); pendingJump = false;
+                    if (recording) recorder.record(replayBits(in, resumed));
+                    resumed = false;
+                } else {
+                    in.jump = pendingJump; pendingJump = false;
+                    in.fastFall = sf::Keyboard::isKeyPressed(sf::Keyboard::Down); // 长按下加速下落
+                    if (recording) recorder.record(replayBits(in, resumed));
+                    resumed = false;
+                }
+                unsigned ev = world.step(in);
+                if (!watching) rewind.record(in, world);
+                if (journal.record(in, world)) persist.journalAppend(journal.batch()); // 每秒一批，后台追加
+                if (journal.checkpointDue(world)) { persist.journalCheckpoint(world); journal.begin(world); }
+
+                if (ev & EV_JUMPED) jumpSound.play();
+                if (ev & EV_MILESTONE) milestoneSound.play(); // 每 100 分提示一次
+                if (ev & EV_COIN) coinSound.play();
+                if ((ev & EV_DIED) && watching) { state = GAME_OVER; bgm.stop(); shutSound.play(); newHs = newHc = false; }
+                else if (ev & EV_DIED) {
+                    state = GAME_OVER; bgm.stop(); shutSound.play(); gameOverClk.restart();
+                    newHs = newHc = false;
+                    journalEnd(); // 这一局已经结束，不再需要恢复
+                    if (recording) {
+                        recording = false;
+                        if (recorder.save("last.replay"))
+                            std::cout << "[replay] last.replay: seed " << world.seed << ", " << recorder.tickCount() << " ticks, score " << world.score() << "\n";
+                    }
+                    if (botUsed) { // 机器人的局不计入最高分，只记录死因，供检查生成器
+                        std::cout << "[bot] seed " << world.seed << " died at tick " << world.tick << ", score " << world.score()
+                                  << ", hit " << SPRITE_FILES[world.killer] << "\n";
+                    } else if (!rewound) { // 每局一条战绩，排行榜在内存里更新，日志在后台追加
+                        RunRecord run = RunRecord();
+                        run.seed = world.seed; run.endedAt = (int64_t)std::time(0);
+                        run.score = world.score(); run.coins = world.coins; run.ticks = world.tick; run.killer = world.killer;
+                        newHs = run.score > 0 && run.score > highScore; // 与计入这一局之前的纪录比，平分不算
+                        newHc = run.coins > 0 && run.coins > highCoins;
+                        board.add(run);
+                        persist.logRun(run, board);
+                        highScore = board.bestScore(); highCoins = board.bestCoins();
+                    }
+                }
             }
-
-            for(size_t i=0; i<coinList.size(); ++i) if (coinList[i].checkCollision(pr)) { coinList[i].collected = true; coins++; } // 吃硬币加计数
-
-            for(int i=cacti.size()-1; i>=0; --i) if(cacti[i].position.x < -100) cacti.erase(cacti.begin()+i); // 清理离屏仙人掌
-            for(int i=coinList.size()-1; i>=0; --i) if(coinList[i].collected || coinList[i].position.x < -50) coinList.erase(coinList.begin()+i); // 清理吃掉/离屏硬币
-            for(int i=birds.size()-1; i>=0; --i) if(birds[i].isOffScreen()) birds.erase(birds.begin()+i); // 清理离屏飞鸟
-
-            float tw = tTrack.getSize().x; g1.move(-spd, 0); g2.move(-spd, 0);
-            if(g1.getPosition().x+tw <= 0) g1.setPosition(g2.getPosition().x+tw, GROUND_Y+30); // 双贴图循环滚动地面
-            if(g2.getPosition().x+tw <= 0) g2.setPosition(g1.getPosition().x+tw, GROUND_Y+30);
         }
 
+        // 渲染位置在最近两步之间插值；暂停/结算时直接用当前状态
+        float alpha = (state == PLAYING && !paused) ? accumulator / SIM_DT : 1.0f;
+
         // --- 渲染逻辑 ---
 
         window.clear(UI_BG); 
@@ -652,12 +919,113 @@ int main() {
             drawCenteredText(window, hsText, WINDOW_WIDTH/2, 95); // 绘制高分
 
             // 绘制菜单按钮
-            for (int i = 0; i < 5; ++i) {
-                float bx = WINDOW_WIDTH/2 - 110; float by = 140 + i * 46; 
+            for (int i = 0; i < 6; ++i) {
+                float bx = WINDOW_WIDTH/2 - 110; float by = 120 + i * 44; 
                 bool hover = (worldPos.x > bx && worldPos.x < bx+220 && worldPos.y > by && worldPos.y < by+40);
                 drawButton(window, font, menu[i], bx, by, 220, 40, hover);
             }
         }
+        // 存档位列表：每个存档位一张卡片，内容全部来自映射的索引
+        else if (state == SLOTS) {
+            sf::Text t; t.setFont(font); t.setFillColor(UI_PRIMARY);
+            t.setCharacterSize(32); t.setStyle(sf::Text::Bold); t.setString(slotsForSave ? "SAVE GAME" : "LOAD GAME");
+            drawCenteredText(window, t, WINDOW_WIDTH/2, 50);
+
+            for (int i = 0; i < SAVE_SLOTS; ++i) {
+                float bx = 40 + i * 185; float by = 100;
+                bool hover = (worldPos.x > bx && worldPos.x < bx+165 && worldPos.y > by && worldPos.y < by+210);
+                drawCard(window, bx, by, 165, 210);
+                if (hover) {
+                    sf::RectangleShape hl(sf::Vector2f(165, 210)); hl.setPosition(bx, by);
+                    hl.setFillColor(sf::Color::Transparent); hl.setOutlineThickness(2);
+                    hl.setOutlineColor(slotsForSave ? UI_SUCCESS : UI_PRIMARY);
+                    window.draw(hl);
+                }
+
+                t.setCharacterSize(16); t.setStyle(sf::Text::Bold); t.setFillColor(UI_TEXT_DARK);
+                t.setString("SLOT " + intToString(i + 1));
+                drawCenteredText(window, t, bx + 82, by + 16);
+
+                sf::RectangleShape frame(sf::Vector2f(160, 80)); frame.setPosition(bx + 2.5f, by + 36);
+                frame.setFillColor(sf::Color(240, 240, 245));
+                window.draw(frame);
+                if (!slotUsed[i]) {
+                    t.setStyle(sf::Text::Regular); t.setFillColor(sf::Color(150, 150, 150)); t.setString("EMPTY");
+                    drawCenteredText(window, t, bx + 82, by + 72);
+                    continue;
+                }
+                sf::Sprite thumb(slotTex[i]);
+                thumb.setPosition(bx + 2.5f, by + 36);
+                thumb.setScale(160.0f / SLOT_THUMB_W, 80.0f / SLOT_THUMB_H);
+                window.draw(thumb);
+
+                t.setStyle(sf::Text::Regular); t.setCharacterSize(16);
+                t.setFillColor(UI_PRIMARY); t.setString("SCORE " + formatScore((int)(slotInfo[i].dist * SCORE_MULTIPLIER)));
+                drawCenteredText(window, t, bx + 82, by + 136);
+                t.setFillColor(sf::Color(255, 140, 0)); t.setString("COINS " + intToString(slotInfo[i].coins));
+                drawCenteredText(window, t, bx + 82, by + 160);
+                t.setCharacterSize(13); t.setFillColor(sf::Color(100, 100, 100)); t.setString(formatSaveTime(slotInfo[i].savedAt));
+                drawCenteredText(window, t, bx + 82, by + 186);
+            }
+
+            t.setString(slotsForSave ? "[1-4] / CLICK TO SAVE   [ESC] BACK" : "[1-4] / CLICK TO LOAD   [ESC] BACK");
+            t.setCharacterSize(16); t.setFillColor(UI_ACCENT); t.setStyle(sf::Text::Bold);
+            drawCenteredText(window, t, WINDOW_WIDTH/2, 350);
+        }
+        // 恢复提示：背后是崩溃前的局面
+        else if (state == RECOVER) {
+            batch.clear();
+            drawWorld(batch, world, 1.0f);
+            batch.draw(window);
+            sf::RectangleShape mask(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
+            mask.setFillColor(sf::Color(0,0,0,100)); 
+            window.draw(mask);
+            drawCard(window, WINDOW_WIDTH/2 - 180, 90, 360, 200);
+
+            sf::Text t; t.setFont(font); 
+            t.setString("UNFINISHED RUN"); t.setCharacterSize(32); t.setFillColor(UI_PRIMARY); t.setStyle(sf::Text::Bold);
+            drawCenteredText(window, t, WINDOW_WIDTH/2, 125);
+            t.setCharacterSize(20); t.setStyle(sf::Text::Regular); t.setFillColor(UI_TEXT_DARK);
+            t.setString("SCORE " + formatScore(world.score()) + "   COINS " + intToString(world.coins));
+            drawCenteredText(window, t, WINDOW_WIDTH/2, 185);
+            t.setCharacterSize(16); t.setStyle(sf::Text::Bold); t.setFillColor(UI_ACCENT);
+            t.setString("[ENTER] CONTINUE      [ESC] DISCARD");
+            drawCenteredText(window, t, WINDOW_WIDTH/2, 245);
+        }
+        // 排行榜：前 RUNLOG_TOP_N 局，数据全部来自内存里的索引
+        else if (state == LEADERBOARD) {
+            drawCard(window, 80, 20, WINDOW_WIDTH-160, WINDOW_HEIGHT-40);
+            sf::Text t; t.setFont(font); t.setFillColor(UI_PRIMARY);
+            t.setCharacterSize(28); t.setStyle(sf::Text::Bold); t.setString("LEADERBOARD");
+            drawCenteredText(window, t, WINDOW_WIDTH/2, 45);
+
+            const float colX[6] = { 110, 160, 260, 340, 430, 530 };
+            const char* heads[6] = { "#", "SCORE", "COINS", "TIME", "CAUSE", "SEED" };
+            t.setCharacterSize(14); t.setFillColor(UI_TEXT_DARK);
+            for (int c = 0; c < 6; ++c) { t.setString(heads[c]); t.setPosition(colX[c], 75); window.draw(t); }
+
+            const RunIndex& top = board.index();
+            t.setStyle(sf::Text::Regular); t.setCharacterSize(15);
+            for (unsigned r = 0; r < top.count; ++r) {
+                const RunRecord& run = top.top[r];
+                std::ostringstream dur;
+                dur << std::fixed << std::setprecision(1) << run.ticks * SIM_DT << "s";
+                std::string cols[6] = { intToString(r + 1), formatScore(run.score), intToString(run.coins),
+                                        run.killer < 0 ? "-" : dur.str(), causeName(run.killer), run.killer < 0 ? "-" : intToString((int)run.seed) };
+                t.setFillColor(r == 0 ? UI_GOLD : UI_TEXT_DARK);
+                for (int c = 0; c < 6; ++c) { t.setString(cols[c]); t.setPosition(colX[c], 98 + r * 22.0f); window.draw(t); }
+            }
+            if (top.count == 0) {
+                t.setFillColor(sf::Color(150, 150, 150)); t.setString("No runs yet");
+                drawCenteredText(window, t, WINDOW_WIDTH/2, 180);
+            }
+
+            t.setCharacterSize(13); t.setFillColor(sf::Color(100, 100, 100));
+            t.setString(intToString((int)top.totalRuns) + " runs logged   best coins " + intToString(top.bestCoins));
+            drawCenteredText(window, t, WINDOW_WIDTH/2, 330);
+            t.setString("[ ENTER to Return ]"); t.setCharacterSize(16); t.setFillColor(UI_ACCENT); t.setStyle(sf::Text::Bold);
+            drawCenteredText(window, t, WINDOW_WIDTH/2, 355);
+        }
         // 绘制说明页面（轻度美化）
         else if (state == INTRO) {
             drawCard(window, 80, 40, WINDOW_WIDTH-160, WINDOW_HEIGHT-80); // 调整卡片尺寸
@@ -677,6 +1045,8 @@ int main() {
                 "  [Space / Up]     Jump\n"
                 "  [Down]             Drop Fast\n"
                 "  [P]                   Pause Menu\n"
+                "  [B]                   Bot Plays For You\n"
+                "  [LEFT]              Rewind After A Crash\n"
                 "  [ESC]               Back to Menu";
             t.setString(content);
             t.setPosition(160, 120); // 设定正文起始位置
@@ -716,15 +1086,26 @@ int main() {
             drawCenteredText(window, t, WINDOW_WIDTH/2, 310);
         }
         else if (state == PLAYING || state == COUNTDOWN) {
-            window.draw(g1); window.draw(g2); 
-            dino.draw(window); 
-            for(size_t i=0; i<cacti.size(); ++i) cacti[i].draw(window); 
-            for(size_t i=0; i<coinList.size(); ++i) coinList[i].draw(window); 
-            for(size_t i=0; i<birds.size(); ++i) birds[i].draw(window); 
+            batch.clear(); // 整个场景合并为一次 draw
+            drawWorld(batch, world, alpha); 
+            batch.draw(window);
+            if (obsOverlay) { // 观测帧着红色半透明叠加
+                obsRenderer.render(world, obsGray.data());
+                for (size_t i = 0; i < obsGray.size(); ++i) {
+                    obsRgba[i * 4] = 255; obsRgba[i * 4 + 1] = obsRgba[i * 4 + 2] = 0;
+                    obsRgba[i * 4 + 3] = (sf::Uint8)(obsGray[i] * 160 / 255);
+                }
+                obsTex.update(obsRgba.data());
+                sf::Sprite o(obsTex);
+                o.setScale((float)WINDOW_WIDTH / obsRenderer.width(), (float)WINDOW_HEIGHT / obsRenderer.height());
+                window.draw(o);
+            }
 
-            drawHudItem(window, 20, 20, "SCORE", formatScore((int)(dist * SCORE_MULTIPLIER)), font, UI_PRIMARY);
+            drawHudItem(window, 20, 20, "SCORE", formatScore(world.score()), font, UI_PRIMARY);
             drawHudItem(window, 180, 20, "HI", formatScore(highScore), font, UI_GOLD);
-            drawHudItem(window, 340, 20, "COINS", intToString(coins), font, sf::Color(255, 140, 0));
+            drawHudItem(window, 340, 20, "COINS", intToString(world.coins), font, sf::Color(255, 140, 0));
+            if (botPlaying && !watching) drawHudItem(window, 500, 20, "PLAYER", "BOT", font, UI_SUCCESS);
+            if (watching) drawHudItem(window, 500, 20, "REPLAY", intToString(player.position()) + "/" + intToString(player.ticks()), font, UI_ACCENT);
 
             if (state == PLAYING && paused) {
                 sf::RectangleShape mask(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
@@ -744,10 +1125,15 @@ int main() {
                     drawButton(window, font, pauseMenu[i], bx, by, 220, 40, hover, hoverColor);
                 }
 
-                if (savedMsg) {
+                if (persist.saving()) {
+                    sf::Text st; st.setFont(font); st.setString("Saving..."); 
+                    st.setFillColor(UI_TEXT_DARK); st.setCharacterSize(18); st.setStyle(sf::Text::Bold);
+                    drawCenteredText(window, st, WINDOW_WIDTH/2, WINDOW_HEIGHT/2 + 110);
+                }
+                else if (savedMsg) {
                         if (msgClk.getElapsedTime().asSeconds() < 2.0f) {
-                            sf::Text st; st.setFont(font); st.setString("Progress Saved!"); 
-                            st.setFillColor(UI_SUCCESS); st.setCharacterSize(18); st.setStyle(sf::Text::Bold);
+                            sf::Text st; st.setFont(font); st.setString(saveFailed ? "Save Failed!" : "Progress Saved!"); 
+                            st.setFillColor(saveFailed ? UI_ACCENT : UI_SUCCESS); st.setCharacterSize(18); st.setStyle(sf::Text::Bold);
                         drawCenteredText(window, st, WINDOW_WIDTH/2, WINDOW_HEIGHT/2 + 110); // 放在下方提示
                     } else savedMsg = false;
                 }
@@ -778,18 +1164,16 @@ int main() {
         }
         // 绘制游戏结束界面（轻度美化）
         else if (state == GAME_OVER) {
-            window.draw(g1); window.draw(g2); 
-            dino.draw(window); 
-            for(size_t i=0; i<cacti.size(); ++i) cacti[i].draw(window); 
+            batch.clear(); 
+            drawWorld(batch, world, 1.0f, true); 
+            batch.draw(window);
             sf::RectangleShape mask(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
             mask.setFillColor(sf::Color(0,0,0,150)); 
             window.draw(mask);
 
             drawCard(window, WINDOW_WIDTH/2 - 160, 50, 320, 280); // 绘制卡片
             
-            int currentScore = (int)(dist * SCORE_MULTIPLIER);
-            bool newHs = (currentScore >= highScore && currentScore > 0);
-            bool newHc = (coins >= highCoins && coins > 0);
+            int currentScore = world.score();
 
             // 显示破纪录提示（避免重复提示）
             if (newHs || newHc) {
@@ -815,10 +1199,39 @@ int main() {
             drawCenteredText(window, t, WINDOW_WIDTH/2, 205);
 
             t.setCharacterSize(16); t.setStyle(sf::Text::Bold); t.setFillColor(UI_TEXT_DARK);
-            t.setString("[R] RESTART      [ESC] MENU"); 
+            t.setString(watching || rewind.empty() ? "[R] RESTART      [ESC] MENU" : "[R] RESTART   [LEFT] REWIND   [ESC] MENU"); 
             drawCenteredText(window, t, WINDOW_WIDTH/2, 280);
         }
 
+        // 倒回：显示历史中的局面，底部提示操作
+        else if (state == REWIND) {
+            batch.clear();
+            drawWorld(batch, rewindView, 1.0f);
+            batch.draw(window);
+            sf::RectangleShape mask(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
+            mask.setFillColor(sf::Color(33, 150, 243, 40));
+            window.draw(mask);
+
+            std::ostringstream back;
+            back << "-" << std::fixed << std::setprecision(1) << (rewind.lastTick() - (uint32_t)rewindCursor) * SIM_DT << "s";
+            drawHudItem(window, 20, 20, "SCORE", formatScore(rewindView.score()), font, UI_PRIMARY);
+            drawHudItem(window, 180, 20, "COINS", intToString(rewindView.coins), font, sf::Color(255, 140, 0));
+            drawHudItem(window, 340, 20, "REWIND", back.str(), font, UI_ACCENT);
+
+            sf::Text t; t.setFont(font); t.setCharacterSize(16); t.setStyle(sf::Text::Bold); t.setFillColor(UI_TEXT_DARK);
+            t.setString("[LEFT / RIGHT] SCRUB   [SPACE] RESUME HERE   [ESC] BACK");
+            drawCenteredText(window, t, WINDOW_WIDTH/2, WINDOW_HEIGHT - 40);
+        }
+
+        if (perfOverlay) { // F3：帧率与回退缓冲（固定上限）占用
+            std::ostringstream os;
+            os << std::fixed << std::setprecision(0) << fpsAvg << " FPS   rewind " << rewind.bytes() / 1024 << " KB cap, "
+               << std::setprecision(1) << (rewind.empty() ? 0.0f : (rewind.lastTick() - rewind.firstTick()) * SIM_DT) << " s held";
+            sf::Text p; p.setFont(font); p.setCharacterSize(12); p.setFillColor(UI_TEXT_DARK);
+            p.setString(os.str()); p.setPosition(8, WINDOW_HEIGHT - 18);
+            window.draw(p);
+        }
+
         window.display(); 
     }
     return 0; 
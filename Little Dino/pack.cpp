@@ -0,0 +1,91 @@
+// ==========================================
+// 资源打包工具：把散落的资源文件打成一个 Game.pak
+// 用法：pack <输出.pak> [--raw] 文件...
+//   --raw  PNG 预先解码为 RGBA 像素存入，运行时跳过 PNG 解压
+// ==========================================
+#include <SFML/Graphics.hpp>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "Bundle.h"
+
+static bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static std::string baseName(const std::string& path) {
+    size_t p = path.find_last_of("/\\");
+    return p == std::string::npos ? path : path.substr(p + 1);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: pack <out.pak> [--raw] files...\n";
+        return 1;
+    }
+    std::string outPath = argv[1];
+    bool raw = false;
+    std::vector<std::string> inputs;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--raw") == 0) raw = true;
+        else inputs.push_back(argv[i]);
+    }
+
+    std::vector<BundleEntry> index(inputs.size());
+    std::vector<std::vector<char> > blobs(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        BundleEntry& e = index[i];
+        std::memset(&e, 0, sizeof(e));
+        std::string name = baseName(inputs[i]);
+        if (name.size() >= (size_t)BUNDLE_NAME_LEN) { std::cerr << "name too long: " << name << "\n"; return 1; }
+        std::memcpy(e.name, name.c_str(), name.size());
+
+        if (raw && endsWith(name, ".png")) {
+            sf::Image img;
+            if (!img.loadFromFile(inputs[i])) { std::cerr << "cannot decode " << inputs[i] << "\n"; return 1; }
+            e.kind = BUNDLE_RGBA;
+            e.width = img.getSize().x; e.height = img.getSize().y;
+            const char* px = reinterpret_cast<const char*>(img.getPixelsPtr());
+            blobs[i].assign(px, px + (size_t)e.width * e.height * 4);
+        } else {
+            std::ifstream in(inputs[i].c_str(), std::ios::binary);
+            if (!in.is_open()) { std::cerr << "cannot open " << inputs[i] << "\n"; return 1; }
+            e.kind = BUNDLE_FILE;
+            blobs[i].assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        e.size = blobs[i].size();
+    }
+
+    // 数据区紧跟索引，每个资源按 BUNDLE_ALIGN 对齐
+    uint64_t offset = sizeof(BundleHeader) + index.size() * sizeof(BundleEntry);
+    for (size_t i = 0; i < index.size(); ++i) {
+        offset = (offset + BUNDLE_ALIGN - 1) / BUNDLE_ALIGN * BUNDLE_ALIGN;
+        index[i].offset = offset;
+        offset += index[i].size;
+    }
+
+    BundleHeader h;
+    std::memcpy(h.magic, BUNDLE_MAGIC, 4);
+    h.version = BUNDLE_VERSION;
+    h.count = (uint32_t)index.size();
+    h.reserved = 0;
+
+    std::ofstream out(outPath.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) { std::cerr << "cannot write " << outPath << "\n"; return 1; }
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(BundleEntry));
+    uint64_t pos = sizeof(BundleHeader) + index.size() * sizeof(BundleEntry);
+    for (size_t i = 0; i < index.size(); ++i) {
+        static const char zeros[BUNDLE_ALIGN] = { 0 };
+        out.write(zeros, (std::streamsize)(index[i].offset - pos));
+        out.write(blobs[i].data(), (std::streamsize)blobs[i].size());
+        pos = index[i].offset + index[i].size;
+        std::cout << "  " << index[i].name << (index[i].kind == BUNDLE_RGBA ? "  rgba " : "  file ") << index[i].size << " bytes\n";
+    }
+    if (!out) { std::cerr << "write failed: " << outPath << "\n"; return 1; }
+    std::cout << outPath << ": " << index.size() << " assets, " << pos << " bytes\n";
+    return 0;
+}
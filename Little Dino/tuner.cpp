@@ -0,0 +1,301 @@
+// ==========================================
+// 难度调参：对参数网格中的每一组，在全部核心上并行跑 N 局无头游戏，
+// 统计存活距离分布与死因，输出 CSV / JSON
+// 用法：tuner [--games N] [--seed S] [--policy none|random|react|search] [--max-ticks T] [--threads K]
+//             [--pak Game.pak] [--rect] [--bucket B] [--csv out.csv] [--json out.json]
+//             [--speed-mult a,b,...] [--speed-ramp ...] [--max-speed ...] [--bird-dist ...]
+//             [--cactus-min ...] [--cactus-spread ...]
+// 每个参数给逗号分隔的取值，网格为各参数取值的笛卡尔积，未给出的参数保持默认。
+// 第 k 局的种子为 S + k，各组参数用同一批种子，便于成对比较
+// ==========================================
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GameWorld.h"
+#include "SimTools.h"
+#include "WorkerPool.h"
+
+const char* USAGE =
+    "Usage: tuner [--games N] [--seed S] [--policy none|random|react|search] [--max-ticks T] [--threads K]\n"
+    "             [--pak Game.pak] [--rect] [--bucket B] [--csv out.csv] [--json out.json]\n"
+    "             [--speed-mult a,b,...] [--speed-ramp ...] [--max-speed ...] [--bird-dist ...]\n"
+    "             [--cactus-min ...] [--cactus-spread ...]\n";
+
+// 可扫描的参数：命令行名、CSV/JSON 列名、在 Difficulty 中的位置、能否取 0、下限（均不能为负）
+struct ParamSpec {
+    const char* flag;
+    const char* column;
+    float Difficulty::* field;
+    bool allowZero;
+    float minValue;
+};
+
+const ParamSpec PARAMS[] = {
+    { "--speed-mult",    "speed_mult",    &Difficulty::speedMultiplier, false, 0 },
+    { "--speed-ramp",    "speed_ramp",    &Difficulty::speedRamp,       true,  0 },  // 0：全程匀速
+    { "--max-speed",     "max_speed",     &Difficulty::maxSpeed,        false, 0 },
+    { "--bird-dist",     "bird_dist",     &Difficulty::birdMinDistance, true,  0 },  // 0：开局就有飞鸟
+    { "--cactus-min",    "cactus_min",    &Difficulty::cactusMin,       false, CACTUS_MIN_FLOOR },
+    { "--cactus-spread", "cactus_spread", &Difficulty::cactusSpread,    true,  0 },  // 0：固定间隔
+};
+const int PARAM_COUNT = sizeof(PARAMS) / sizeof(PARAMS[0]);
+
+// 死因：按撞上的障碍物分类，跑满步数上限算存活
+enum DeathCause { CAUSE_CACTUS_LARGE, CAUSE_CACTUS_SMALL1, CAUSE_CACTUS_SMALL2, CAUSE_BIRD, CAUSE_SURVIVED, CAUSE_COUNT };
+const char* CAUSE_NAMES[CAUSE_COUNT] = { "cactus_large", "cactus_small1", "cactus_small2", "bird", "survived" };
+
+DeathCause causeOf(int killer) {
+    if (killer == SPR_CACTUS_L) return CAUSE_CACTUS_LARGE;
+    if (killer == SPR_CACTUS_S1) return CAUSE_CACTUS_SMALL1;
+    if (killer == SPR_CACTUS_S2) return CAUSE_CACTUS_SMALL2;
+    if (killer == SPR_BIRD_UP || killer == SPR_BIRD_DOWN) return CAUSE_BIRD;
+    return CAUSE_SURVIVED;
+}
+
+const int MAX_HISTOGRAM_BINS = 4096;
+
+struct GameResult {
+    float dist;
+    int score, coins;
+    uint32_t ticks;
+    uint32_t drops;     // 实体缓冲已满而丢弃的生成
+    unsigned char cause;
+};
+
+struct SetStats {
+    double mean, stddev, minD, p10, p25, p50, p75, p90, maxD;
+    double scoreMean, coinsMean, ticksMean;
+    long long drops;
+    int causes[CAUSE_COUNT];
+    std::vector<int> histogram;
+};
+
+// 逗号分隔的取值；非数字、无穷、NaN、小于 minValue（以及 allowZero 为假时的 0）都视为错误
+bool parseList(const char* s, bool allowZero, float minValue, std::vector<float>& out) {
+    out.clear();
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        char* end = 0;
+        float v = std::strtof(item.c_str(), &end);
+        if (item.empty() || *end || !std::isfinite(v) || v < minValue || (v == 0 && !allowZero)) return false;
+        out.push_back(v);
+    }
+    return !out.empty();
+}
+
+void playGames(const GameWorld& proto, Policy policy, uint32_t seed, int first, int last, long long maxTicks, GameResult* out) {
+    GameWorld world(proto);
+    ScriptedPlayer player(policy);
+    for (int g = first; g < last; ++g) {
+        world.reset(seed + g);
+        player.reset(seed + g);
+        uint32_t drops = world.spawnDrops;
+        long long t = 0;
+        while (t < maxTicks) {
+            ++t;
+            if (world.step(player.input(world)) & EV_DIED) break;
+        }
+        GameResult& r = out[g];
+        r.dist = world.dist; r.score = world.score(); r.coins = world.coins;
+        r.ticks = (uint32_t)t; r.drops = world.spawnDrops - drops; r.cause = (unsigned char)causeOf(world.killer);
+    }
+}
+
+double percentile(const std::vector<float>& sorted, double q) {
+    return sorted[(size_t)(q * (sorted.size() - 1) + 0.5)];
+}
+
+SetStats summarize(const GameResult* r, int games, float bucket) {
+    SetStats s;
+    std::vector<float> d(games);
+    double sum = 0, sq = 0, score = 0, coins = 0, ticks = 0;
+    for (int c = 0; c < CAUSE_COUNT; ++c) s.causes[c] = 0;
+    s.drops = 0;
+    for (int g = 0; g < games; ++g) {
+        d[g] = r[g].dist;
+        sum += r[g].dist; sq += (double)r[g].dist * r[g].dist;
+        score += r[g].score; coins += r[g].coins; ticks += r[g].ticks; s.drops += r[g].drops;
+        ++s.causes[r[g].cause];
+    }
+    std::sort(d.begin(), d.end());
+    s.mean = sum / games;
+    s.stddev = std::sqrt(std::max(0.0, sq / games - s.mean * s.mean));
+    s.minD = d.front(); s.maxD = d.back();
+    s.p10 = percentile(d, 0.10); s.p25 = percentile(d, 0.25); s.p50 = percentile(d, 0.50);
+    s.p75 = percentile(d, 0.75); s.p90 = percentile(d, 0.90);
+    s.scoreMean = score / games; s.coinsMean = coins / games; s.ticksMean = ticks / games;
+    s.histogram.assign((size_t)(d.back() / bucket) + 1, 0);
+    for (int g = 0; g < games; ++g) ++s.histogram[(size_t)(d[g] / bucket)];
+    return s;
+}
+
+void writeCsv(std::ostream& out, const std::vector<Difficulty>& grid, const std::vector<SetStats>& stats, int games) {
+    for (int p = 0; p < PARAM_COUNT; ++p) out << PARAMS[p].column << ",";
+    out << "games,dist_mean,dist_std,dist_min,dist_p10,dist_p25,dist_p50,dist_p75,dist_p90,dist_max,score_mean,coins_mean,ticks_mean";
+    for (int c = 0; c < CAUSE_COUNT; ++c) out << "," << (c == CAUSE_SURVIVED ? "" : "death_") << CAUSE_NAMES[c];
+    out << ",spawn_drops\n";
+    for (size_t i = 0; i < grid.size(); ++i) {
+        const SetStats& s = stats[i];
+        for (int p = 0; p < PARAM_COUNT; ++p) out << grid[i].*PARAMS[p].field << ",";
+        out << games << "," << s.mean << "," << s.stddev << "," << s.minD << "," << s.p10 << "," << s.p25 << "," << s.p50 << ","
+            << s.p75 << "," << s.p90 << "," << s.maxD << "," << s.scoreMean << "," << s.coinsMean << "," << s.ticksMean;
+        for (int c = 0; c < CAUSE_COUNT; ++c) out << "," << s.causes[c];
+        out << "," << s.drops << "\n";
+    }
+}
+
+void writeJson(std::ostream& out, const std::vector<Difficulty>& grid, const std::vector<SetStats>& stats,
+               int games, uint32_t seed, Policy policy, long long maxTicks, bool pixel, float bucket) {
+    out << "{\n  \"policy\": \"" << policyName(policy) << "\", \"games\": " << games << ", \"seed\": " << seed
+        << ", \"max_ticks\": " << maxTicks << ", \"collision\": \"" << (pixel ? "pixel" : "rect") << "\",\n  \"sets\": [\n";
+    for (size_t i = 0; i < grid.size(); ++i) {
+        const SetStats& s = stats[i];
+        out << "    {\"params\": {";
+        for (int p = 0; p < PARAM_COUNT; ++p) out << (p ? ", " : "") << "\"" << PARAMS[p].column << "\": " << grid[i].*PARAMS[p].field;
+        out << "},\n     \"distance\": {\"mean\": " << s.mean << ", \"std\": " << s.stddev << ", \"min\": " << s.minD
+            << ", \"p10\": " << s.p10 << ", \"p25\": " << s.p25 << ", \"p50\": " << s.p50 << ", \"p75\": " << s.p75
+            << ", \"p90\": " << s.p90 << ", \"max\": " << s.maxD << "},\n";
+        out << "     \"score_mean\": " << s.scoreMean << ", \"coins_mean\": " << s.coinsMean << ", \"ticks_mean\": " << s.ticksMean
+            << ", \"spawn_drops\": " << s.drops << ",\n";
+        out << "     \"causes\": {";
+        for (int c = 0; c < CAUSE_COUNT; ++c) out << (c ? ", " : "") << "\"" << CAUSE_NAMES[c] << "\": " << s.causes[c];
+        out << "},\n     \"histogram\": {\"bucket\": " << bucket << ", \"counts\": [";
+        for (size_t b = 0; b < s.histogram.size(); ++b) out << (b ? ", " : "") << s.histogram[b];
+        out << "]}}" << (i + 1 < grid.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    int games = 1000;
+    uint32_t seed = 1;
+    Policy policy = POLICY_REACT;
+    long long maxTicks = 60LL * 60 * 60; // 每局最多一小时游戏时间
+    unsigned threads = 0;
+    std::string pakPath = "Game.pak", csvPath, jsonPath;
+    bool rectOnly = false;
+    float bucket = 250.0f;
+    std::vector<float> values[PARAM_COUNT];
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        int p = 0;
+        while (p < PARAM_COUNT && a != PARAMS[p].flag) ++p;
+        if (p < PARAM_COUNT && hasValue) {
+            const ParamSpec& ps = PARAMS[p];
+            if (!parseList(argv[++i], ps.allowZero, ps.minValue, values[p])) {
+                std::cerr << "Bad value list for " << a << ": " << argv[i] << " (need finite numbers, "
+                          << (ps.allowZero || ps.minValue > 0 ? ">= " : "> ") << ps.minValue << ")\n";
+                return 1;
+            }
+        }
+        else if (a == "--games" && hasValue) games = std::atoi(argv[++i]);
+        else if (a == "--seed" && hasValue) seed = (uint32_t)std::strtoul(argv[++i], 0, 10);
+        else if (a == "--policy" && hasValue) {
+            std::string name = argv[++i];
+            if (!parsePolicy(name, policy)) { std::cerr << "Unknown policy: " << name << "\n"; return 1; }
+        }
+        else if (a == "--max-ticks" && hasValue) maxTicks = std::atoll(argv[++i]);
+        else if (a == "--threads" && hasValue) threads = (unsigned)std::atoi(argv[++i]);
+        else if (a == "--pak" && hasValue) pakPath = argv[++i];
+        else if (a == "--rect") rectOnly = true;
+        else if (a == "--bucket" && hasValue) {
+            std::vector<float> b;
+            if (!parseList(argv[++i], false, 0, b) || b.size() != 1) { std::cerr << "Bad value for --bucket: " << argv[i] << " (need one finite number > 0)\n"; return 1; }
+            bucket = b[0];
+        }
+        else if (a == "--csv" && hasValue) csvPath = argv[++i];
+        else if (a == "--json" && hasValue) jsonPath = argv[++i];
+        else { std::cerr << USAGE; return 1; }
+    }
+    if (games < 1 || maxTicks < 1) { std::cerr << USAGE; return 1; }
+
+    // 参数网格：未扫描的参数取默认值
+    Difficulty base = defaultDifficulty();
+    for (int p = 0; p < PARAM_COUNT; ++p) if (values[p].empty()) values[p].push_back(base.*PARAMS[p].field);
+    std::vector<Difficulty> grid(1, base);
+    for (int p = 0; p < PARAM_COUNT; ++p) {
+        std::vector<Difficulty> next;
+        for (size_t i = 0; i < grid.size(); ++i)
+            for (size_t v = 0; v < values[p].size(); ++v) { Difficulty d = grid[i]; d.*PARAMS[p].field = values[p][v]; next.push_back(d); }
+        grid.swap(next);
+    }
+
+    // 直方图区间数 = 最远距离 / bucket；速度不超过 maxSpeed，最远距离在开跑前就有上限
+    double farthest = 0;
+    for (size_t i = 0; i < grid.size(); ++i) farthest = std::max(farthest, (double)maxTicks * SIM_DT * grid[i].maxSpeed);
+    if (farthest / bucket > MAX_HISTOGRAM_BINS) {
+        std::cerr << "Bad value for --bucket: " << bucket << " (up to " << MAX_HISTOGRAM_BINS << " bins; with --max-ticks "
+                  << maxTicks << " need >= " << farthest / MAX_HISTOGRAM_BINS << ")\n";
+        return 1;
+    }
+
+    SpriteMetrics metrics = defaultSpriteMetrics();
+    static PixelMask masks[SPR_COUNT];
+    bool pixel = !rectOnly && loadMasks(pakPath, metrics, masks);
+
+    // 每个任务跑同一组参数下连续的若干局；结果按局号写入，与线程数无关
+    const int CHUNK = 16;
+    std::vector<GameResult> results((size_t)grid.size() * games);
+    std::vector<GameWorld> protos(grid.size(), GameWorld(metrics));
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    {
+        WorkerPool pool(threads);
+        threads = pool.size();
+        for (size_t i = 0; i < grid.size(); ++i) {
+            protos[i].setDifficulty(grid[i]);
+            if (pixel) protos[i].setMasks(masks);
+            for (int g = 0; g < games; g += CHUNK) {
+                const GameWorld* proto = &protos[i];
+                GameResult* out = &results[i * games];
+                int last = std::min(games, g + CHUNK);
+                pool.submit([=] { playGames(*proto, policy, seed, g, last, maxTicks, out); });
+            }
+        }
+        pool.wait();
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::vector<SetStats> stats;
+    long long totalTicks = 0;
+    for (size_t i = 0; i < grid.size(); ++i) {
+        stats.push_back(summarize(&results[i * games], games, bucket));
+        totalTicks += (long long)(stats.back().ticksMean * games + 0.5);
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << grid.size() << " parameter sets x " << games << " games, policy " << policyName(policy)
+              << ", " << (pixel ? "pixel" : "rect") << " collision, " << threads << " threads\n";
+    std::cout << "wall " << sec * 1000.0 << " ms, " << (sec > 0 ? totalTicks / sec / 1e6 : 0.0) << "M ticks/s\n\n";
+    std::cout << "  set   dist mean     p10     p50     p90   survived   top cause\n";
+    for (size_t i = 0; i < grid.size(); ++i) {
+        const SetStats& s = stats[i];
+        int top = 0;
+        for (int c = 1; c < CAUSE_SURVIVED; ++c) if (s.causes[c] > s.causes[top]) top = c;
+        std::cout << std::setw(5) << i << std::setw(12) << s.mean << std::setw(8) << s.p10 << std::setw(8) << s.p50
+                  << std::setw(8) << s.p90 << std::setw(11) << s.causes[CAUSE_SURVIVED] << "   " << CAUSE_NAMES[top] << "\n";
+    }
+    for (size_t i = 0; i < grid.size(); ++i) // 丢掉的实体会让这组的统计偏乐观
+        if (stats[i].drops > 0) std::cout << "warning: set " << i << " dropped " << stats[i].drops << " spawns (entity capacity " << ENTITY_CAPACITY << ")\n";
+
+    if (!csvPath.empty()) {
+        std::ofstream out(csvPath.c_str());
+        if (!out.is_open()) { std::cerr << "Cannot write " << csvPath << "\n"; return 1; }
+        writeCsv(out, grid, stats, games);
+    }
+    if (!jsonPath.empty()) {
+        std::ofstream out(jsonPath.c_str());
+        if (!out.is_open()) { std::cerr << "Cannot write " << jsonPath << "\n"; return 1; }
+        writeJson(out, grid, stats, games, seed, policy, maxTicks, pixel, bucket);
+    }
+    return 0;
+}